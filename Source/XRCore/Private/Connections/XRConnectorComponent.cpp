@@ -1,8 +1,11 @@
 #include "Connections/XRConnectorComponent.h"
+#include "Core/XRCoreStats.h"
 #include "Connections/XRConnectorSocket.h"
 #include "Connections/XRConnectorHologram.h"
 #include "Interactions/XRInteractionGrab.h"
 #include "Utilities/XRToolsUtilityFunctions.h"
+#include "Utilities/XRCoreNetStats.h"
+#include "Utilities/XRDebugRegistrySubsystem.h"
 #include "Utilities/XRReplicatedPhysicsComponent.h"
 
 #include "Net/UnrealNetwork.h"
@@ -32,6 +35,7 @@ UXRConnectorComponent::UXRConnectorComponent()
 void UXRConnectorComponent::BeginPlay()
 {
 	Super::BeginPlay();
+	UXRDebugRegistrySubsystem::Register<UXRConnectorComponent>(this);
 	InitializeOverlapBindings();
 	InitializeInteractionBindings();
 	MinDistanceToConnectSquared = FMath::Square(MinDistanceToConnect);
@@ -39,6 +43,7 @@ void UXRConnectorComponent::BeginPlay()
 
 void UXRConnectorComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+	UXRDebugRegistrySubsystem::Unregister<UXRConnectorComponent>(this);
 	Super::EndPlay(EndPlayReason);
 	if (ConnectedSocket)
 	{
@@ -100,7 +105,12 @@ void UXRConnectorComponent::Server_ConnectToSocket_Implementation(UXRConnectorSo
 		return;
 	}
 
+	if (UXRReplicatedPhysicsComponent* XRPhysicsComponent = GetOwner()->FindComponentByClass<UXRReplicatedPhysicsComponent>())
+	{
+		XRPhysicsComponent->WakeNetDormancy();
+	}
 	ConnectedSocket = InSocket;
+	XRCORE_RECORD_NET_MESSAGE_ESTIMATE(EXRNetFeature::ConnectorState, sizeof(uint32), FXRCoreNetStats::GetNumClientReceivers(GetOwner()));
 
 	if (EstablishConnectionTime <= 0.0f)
 	{
@@ -133,16 +143,20 @@ void UXRConnectorComponent::Server_DisconnectFromSocket_Implementation()
 	UXRReplicatedPhysicsComponent* XRPhysicsComponent = GetOwner()->FindComponentByClass<UXRReplicatedPhysicsComponent>();
 	if (XRPhysicsComponent)
 	{
+		// ConnectedSocket must reach the clients of a resting, dormant owner
+		XRPhysicsComponent->WakeNetDormancy();
 		XRPhysicsComponent->SetSimulatePhysicsOnOwner(true);
 	}
 
 	ConnectedSocket = nullptr;
+	XRCORE_RECORD_NET_MESSAGE_ESTIMATE(EXRNetFeature::ConnectorState, sizeof(uint32), FXRCoreNetStats::GetNumClientReceivers(GetOwner()));
 	DetachFromSocket();
 }
 
 
 UXRConnectorSocket* UXRConnectorComponent::GetClosestOverlappedSocket()
 {
+	XRCORE_SCOPE_CYCLE_COUNTER(STAT_XRCore_ConnectorOverlaps);
 	float MinSqDistance = UE_BIG_NUMBER;
 	UXRConnectorSocket* ClosestSocket = nullptr;
 
@@ -325,6 +339,7 @@ void UXRConnectorComponent::InitializeOverlapBindings()
 
 void UXRConnectorComponent::OnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
 {
+	XRCORE_SCOPE_CYCLE_COUNTER(STAT_XRCore_ConnectorOverlaps);
 	if (UXRConnectorSocket* OverlappedSocket = Cast<UXRConnectorSocket>(OtherComp))
 	{
 		if (!OverlappedSocket->IsConnectionAllowed(this))
@@ -344,6 +359,7 @@ void UXRConnectorComponent::OnOverlapBegin(UPrimitiveComponent* OverlappedCompon
 
 void UXRConnectorComponent::OnOverlapEnd(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
 {
+	XRCORE_SCOPE_CYCLE_COUNTER(STAT_XRCore_ConnectorOverlaps);
 	if (UXRConnectorSocket* OverlappedSocket = Cast<UXRConnectorSocket>(OtherComp))
 	{
 		// Ensure an overlapped Socket is only removed when no Collider on the OwningActor is overlapping it anymore, not just the one that stopped overlapping
@@ -369,6 +385,19 @@ void UXRConnectorComponent::OnOverlapEnd(UPrimitiveComponent* OverlappedComponen
 // ------------------------------------------------------------------------------------------------------------------------------------------------------------
 // Hologram
 // ------------------------------------------------------------------------------------------------------------------------------------------------------------
+int32 UXRConnectorComponent::GetNumVisibleHolograms() const
+{
+	int32 NumVisible = 0;
+	for (const TPair<TWeakObjectPtr<UXRConnectorSocket>, TWeakObjectPtr<AActor>>& Pair : AssignedHolograms)
+	{
+		if (Pair.Value.IsValid() && !Pair.Value->IsHidden())
+		{
+			NumVisible++;
+		}
+	}
+	return NumVisible;
+}
+
 void UXRConnectorComponent::SetHologramState(UXRConnectorSocket* InSocket, EXRHologramState InState)
 {
 	if (!InSocket)
@@ -437,6 +466,7 @@ void UXRConnectorComponent::SetHologramState(UXRConnectorSocket* InSocket, EXRHo
 
 void UXRConnectorComponent::ShowAllAvailableHolograms()
 {
+	XRCORE_SCOPE_CYCLE_COUNTER(STAT_XRCore_Holograms);
 	AActor* Owner = GetOwner();
 	if (!Owner)
 	{
@@ -486,6 +516,7 @@ void UXRConnectorComponent::ShowAllAvailableHolograms()
 
 void UXRConnectorComponent::HideAllHolograms()
 {
+	XRCORE_SCOPE_CYCLE_COUNTER(STAT_XRCore_Holograms);
 	for (const auto& Pair : AssignedHolograms)
 	{
 		const TWeakObjectPtr<AActor>& Hologram = Pair.Value;
@@ -519,8 +550,9 @@ void UXRConnectorComponent::InitializeInteractionBindings()
 	auto FoundInteractionComp = UXRToolsUtilityFunctions::GetXRInteractionByPriority(InteractionComponents, nullptr, 0, EXRInteractionPrioritySelection::LowerEqual,5);
 	if (FoundInteractionComp)
 	{
-		FoundInteractionComp->OnInteractionStarted.AddDynamic(this, &UXRConnectorComponent::OnInteractionStarted);
-		FoundInteractionComp->OnInteractionEnded.AddDynamic(this, &UXRConnectorComponent::OnInteractionEnded);
+		// Native delegates, the socket has to be released within the grab rather than at the end of the frame
+		FoundInteractionComp->OnInteractionStartedNative.AddUObject(this, &UXRConnectorComponent::OnInteractionStarted);
+		FoundInteractionComp->OnInteractionEndedNative.AddUObject(this, &UXRConnectorComponent::OnInteractionEnded);
 		BoundGrabComponent = Cast<UXRInteractionGrab>(FoundInteractionComp);
 	}
 }
@@ -1,7 +1,10 @@
 #include "Core/XRCoreHand.h"
+#include "Core/XRCoreStats.h"
 #include "Core/XRLaserComponent.h"
 #include "Interactions/XRInteractorComponent.h"
 
+#include "Net/UnrealNetwork.h"
+
 AXRCoreHand::AXRCoreHand()
 {
     PrimaryActorTick.bCanEverTick = true;
@@ -35,30 +38,146 @@ void AXRCoreHand::BeginPlay()
 }
 
 // ------------------------------------------------------------------------------------------------------------------------------------------------------------
-// Tick - Interpolate on remote clients towards replicated transform data
+// Tick - Play back buffered replicated transform data on remote clients
 // ------------------------------------------------------------------------------------------------------------------------------------------------------------
 void AXRCoreHand::Tick(float DeltaTime)
 {
+    XRCORE_SCOPE_CYCLE_COUNTER(STAT_XRCore_HandPlayback);
     Super::Tick(DeltaTime);
 
     // Exclude locally controlling client as the HandActor is attached to the MotionController here
-    if (!bIsLocallyControlled)
+    if (bIsLocallyControlled || HandSampleBuffer.Num() == 0)
+    {
+        return;
+    }
+
+    // Playback never runs backwards, even if the clock offset estimate shrinks
+    const double PlaybackTime = FMath::Max(GetWorld()->GetTimeSeconds() - ClockOffset - GetInterpolationDelay(), LastPlaybackTime);
+    LastPlaybackTime = PlaybackTime;
+
+    FVector NewLoc;
+    FQuat NewRot;
+    const bool bIsIdle = SampleHandPose(PlaybackTime, NewLoc, NewRot);
+    SetActorLocationAndRotation(NewLoc, NewRot);
+
+    // Nothing left to play back, the next received sample enables tick again
+    if (bIsIdle)
+    {
+        SetActorTickEnabled(false);
+    }
+}
+
+float AXRCoreHand::GetInterpolationDelay() const
+{
+    return FMath::Clamp(AverageSendInterval + JitterDelayMultiplier * Jitter, MinInterpolationDelay, FMath::Max(MinInterpolationDelay, MaxInterpolationDelay));
+}
+
+void AXRCoreHand::AddHandSample(const FXRCoreHandReplicationData& InSample)
+{
+    const double LocalTime = GetWorld()->GetTimeSeconds();
+
+    // Samples without a sender timestamp are played back by arrival time
+    FXRCoreHandReplicationData Sample = InSample;
+    if (Sample.Timestamp <= 0.0)
+    {
+        Sample.Timestamp = LocalTime;
+    }
+    const double SampleOffset = LocalTime - Sample.Timestamp;
+
+    // First sample, or the sender clock jumped (e.g. after a level change): restart playback
+    if (HandSampleBuffer.Num() == 0 || FMath::Abs(SampleOffset - ClockOffset) > 1.0)
+    {
+        HandSampleBuffer.Reset();
+        HandSampleBuffer.Add(Sample);
+        ClockOffset = SampleOffset;
+        Jitter = 0.0f;
+        LastPlaybackTime = Sample.Timestamp - GetInterpolationDelay();
+        return;
+    }
+
+    // Late samples that playback already passed are of no use
+    if (Sample.Timestamp <= LastPlaybackTime)
+    {
+        return;
+    }
+
+    const double NewestTimestamp = HandSampleBuffer.Last().Timestamp;
+    if (Sample.Timestamp > NewestTimestamp)
+    {
+        AverageSendInterval = FMath::Lerp(AverageSendInterval, static_cast<float>(Sample.Timestamp - NewestTimestamp), 0.1f);
+        HandSampleBuffer.Add(Sample);
+    }
+    else
     {
-        // Current transform of MotionControllerRoot
-        FVector CurrentLoc = GetActorLocation();
-        FQuat CurrentRot = GetActorQuat();
+        const int32 InsertIndex = HandSampleBuffer.IndexOfByPredicate([&Sample](const FXRCoreHandReplicationData& Buffered) { return Buffered.Timestamp >= Sample.Timestamp; });
+        if (HandSampleBuffer[InsertIndex].Timestamp == Sample.Timestamp)
+        {
+            return;
+        }
+        HandSampleBuffer.Insert(Sample, InsertIndex);
+    }
+
+    Jitter = FMath::Lerp(Jitter, static_cast<float>(FMath::Abs(SampleOffset - ClockOffset)), 0.1f);
+    ClockOffset = FMath::Lerp(ClockOffset, SampleOffset, 0.05);
+
+    if (HandSampleBuffer.Num() > MaxBufferedHandSamples)
+    {
+        HandSampleBuffer.RemoveAt(0, HandSampleBuffer.Num() - MaxBufferedHandSamples);
+    }
+}
+
+// Cubic hermite interpolation of the location with tangents from neighbouring samples, slerp for rotation.
+// Returns true once playback is past the newest sample and the extrapolation window.
+bool AXRCoreHand::SampleHandPose(double InPlaybackTime, FVector& OutLocation, FQuat& OutRotation) const
+{
+    const int32 NumSamples = HandSampleBuffer.Num();
+    const FXRCoreHandReplicationData& Oldest = HandSampleBuffer[0];
+    const FXRCoreHandReplicationData& Newest = HandSampleBuffer.Last();
 
-        // Target transform from replicated data
-        FVector TargetLoc = ReplicatedHandData.Location;
-        FQuat TargetRot = ReplicatedHandData.Rotation;
+    if (InPlaybackTime <= Oldest.Timestamp)
+    {
+        OutLocation = Oldest.Location;
+        OutRotation = Oldest.Rotation;
+        return false;
+    }
 
-        // Smooth interpolation
-        FVector NewLoc = FMath::VInterpTo(CurrentLoc, TargetLoc, DeltaTime, InterpolationSpeed);
-        FQuat NewRot = FQuat::FastLerp(CurrentRot, TargetRot, DeltaTime * InterpolationSpeed).GetNormalized();
+    auto GetVelocity = [](const FXRCoreHandReplicationData& From, const FXRCoreHandReplicationData& To)
+    {
+        const double DeltaTime = To.Timestamp - From.Timestamp;
+        return DeltaTime > KINDA_SMALL_NUMBER ? (To.Location - From.Location) / DeltaTime : FVector::ZeroVector;
+    };
 
+    // Bounded extrapolation along the last known velocity
+    if (InPlaybackTime >= Newest.Timestamp)
+    {
+        const double ExtrapolationTime = FMath::Min(InPlaybackTime - Newest.Timestamp, static_cast<double>(MaxExtrapolationTime));
+        const FVector Velocity = NumSamples > 1 ? GetVelocity(HandSampleBuffer[NumSamples - 2], Newest) : FVector::ZeroVector;
+        OutLocation = Newest.Location + Velocity * ExtrapolationTime;
+        OutRotation = Newest.Rotation;
+        return InPlaybackTime - Newest.Timestamp >= MaxExtrapolationTime;
+    }
 
-        SetActorLocationAndRotation(NewLoc, NewRot);
+    int32 SegmentIndex = 0;
+    while (SegmentIndex < NumSamples - 2 && HandSampleBuffer[SegmentIndex + 1].Timestamp <= InPlaybackTime)
+    {
+        SegmentIndex++;
     }
+
+    const FXRCoreHandReplicationData& P0 = HandSampleBuffer[FMath::Max(SegmentIndex - 1, 0)];
+    const FXRCoreHandReplicationData& P1 = HandSampleBuffer[SegmentIndex];
+    const FXRCoreHandReplicationData& P2 = HandSampleBuffer[SegmentIndex + 1];
+    const FXRCoreHandReplicationData& P3 = HandSampleBuffer[FMath::Min(SegmentIndex + 2, NumSamples - 1)];
+
+    const double SegmentDuration = P2.Timestamp - P1.Timestamp;
+    const float Alpha = SegmentDuration > KINDA_SMALL_NUMBER ? static_cast<float>((InPlaybackTime - P1.Timestamp) / SegmentDuration) : 1.0f;
+
+    // Tangents are scaled to the segment duration, so unevenly spaced samples don't overshoot
+    const FVector StartTangent = GetVelocity(P0, P2) * SegmentDuration;
+    const FVector EndTangent = GetVelocity(P1, P3) * SegmentDuration;
+
+    OutLocation = FMath::CubicInterp(P1.Location, StartTangent, P2.Location, EndTangent, Alpha);
+    OutRotation = FQuat::Slerp(P1.Rotation, P2.Rotation, Alpha).GetNormalized();
+    return false;
 }
 
 FXRCoreHandReplicationData AXRCoreHand::GetReplicatedHandData() const
@@ -66,6 +185,129 @@ FXRCoreHandReplicationData AXRCoreHand::GetReplicatedHandData() const
     return ReplicatedHandData;
 }
 
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Replication - property mode
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+void AXRCoreHand::SetServerHandData(const FXRCoreHandReplicationData& InXRCoreHandData)
+{
+    ServerHandData = InXRCoreHandData;
+    ForceNetUpdate();
+
+    // No OnRep on the server: apply the sample, so relevancy, priority, overlaps and the listen server host see the current hand
+    if (GetNetMode() != NM_Client)
+    {
+        IXRCoreHandInterface::Execute_Client_UpdateXRCoreHandReplicationData(this, ServerHandData);
+    }
+}
+
+void AXRCoreHand::OnRep_ServerHandData()
+{
+    IXRCoreHandInterface::Execute_Client_UpdateXRCoreHandReplicationData(this, ServerHandData);
+}
+
+// Multicast hands are culled by the engine as usual, remote clients would lose them otherwise while they still receive the multicasts
+bool AXRCoreHand::IsNetRelevantFor(const AActor* RealViewer, const AActor* ViewTarget, const FVector& SrcLocation) const
+{
+    if (HandReplicationMode != EXRHandReplicationMode::ReplicatedProperty)
+    {
+        return Super::IsNetRelevantFor(RealViewer, ViewTarget, SrcLocation);
+    }
+    // Same early outs as the engine: always relevant, owner and instigator
+    if (bAlwaysRelevant || IsOwnedBy(ViewTarget) || IsOwnedBy(RealViewer) || this == ViewTarget || ViewTarget == GetInstigator())
+    {
+        return true;
+    }
+    // Owner-only, owner relevancy and the relevancy of the attach parent still apply
+    if (!Super::IsNetRelevantFor(RealViewer, ViewTarget, SrcLocation))
+    {
+        return false;
+    }
+    // A hand is never relevant without its avatar
+    if (GetOwner() && !GetOwner()->IsNetRelevantFor(RealViewer, ViewTarget, SrcLocation))
+    {
+        return false;
+    }
+    return FVector::DistSquared(SrcLocation, GetActorLocation()) <= FMath::Square(HandNetCullDistance);
+}
+
+float AXRCoreHand::GetHandNetCullDistance() const
+{
+    if (HandReplicationMode != EXRHandReplicationMode::ReplicatedProperty)
+    {
+        return FMath::Sqrt(NetCullDistanceSquared);
+    }
+    return HandNetCullDistance;
+}
+
+// Nearby hands win when bandwidth is saturated, distant ones are updated less often
+float AXRCoreHand::GetNetPriority(const FVector& ViewPos, const FVector& ViewDir, AActor* Viewer, AActor* ViewTarget, UActorChannel* InChannel, float Time, bool bLowBandwidth)
+{
+    const float BasePriority = Super::GetNetPriority(ViewPos, ViewDir, Viewer, ViewTarget, InChannel, Time, bLowBandwidth);
+    if (HandNetCullDistance <= 0.0f)
+    {
+        return BasePriority;
+    }
+    const float DistanceAlpha = FMath::Clamp(static_cast<float>(FVector::Dist(ViewPos, GetActorLocation())) / HandNetCullDistance, 0.0f, 1.0f);
+    return BasePriority * FMath::Lerp(1.0f, DistantNetPriorityScale, DistanceAlpha);
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Replication - hand joints
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+TArray<FQuat> AXRCoreHand::GetReplicatedHandJoints() const
+{
+    return ReplicatedHandJoints;
+}
+
+void AXRCoreHand::GetHandJointRestPose(TArray<FQuat>& OutRestPose) const
+{
+    OutRestPose.Reset(HandJointRestPose.Num());
+    for (const FRotator& RestRotation : HandJointRestPose)
+    {
+        OutRestPose.Add(RestRotation.Quaternion());
+    }
+}
+
+void AXRCoreHand::ApplyHandJointPacket(const FXRHandJointPacket& InPacket)
+{
+    if (bIsLocallyControlled)
+    {
+        return;
+    }
+    TArray<FXRQuantizedJointRotation> Frame;
+    if (!JointDecoder.Decode(InPacket, Frame))
+    {
+        return;
+    }
+
+    TArray<FQuat> RestPose;
+    GetHandJointRestPose(RestPose);
+    FXRHandJointCodec::DequantizeFrame(Frame, RestPose, InPacket.Precision, ReplicatedHandJoints);
+}
+
+void AXRCoreHand::SetServerHandJoints(const FXRHandJointPacket& InPacket)
+{
+    ServerHandJoints = InPacket;
+    ForceNetUpdate();
+
+    if (GetNetMode() != NM_Client)
+    {
+        ApplyHandJointPacket(ServerHandJoints);
+    }
+}
+
+void AXRCoreHand::OnRep_ServerHandJoints()
+{
+    ApplyHandJointPacket(ServerHandJoints);
+}
+
+void AXRCoreHand::GetLifetimeReplicatedProps(TArray< FLifetimeProperty >& OutLifetimeProps) const
+{
+    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+    DOREPLIFETIME_CONDITION(AXRCoreHand, ServerHandData, COND_SkipOwner);
+    DOREPLIFETIME_CONDITION(AXRCoreHand, ServerHandJoints, COND_SkipOwner);
+}
+
 // ------------------------------------------------------------------------------------------------------------------------------------------------------------
 // XRCoreHand Interface Implementations
 // ------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -123,5 +365,7 @@ void AXRCoreHand::Client_UpdateXRCoreHandReplicationData_Implementation(const FX
     if (!bIsLocallyControlled)
     {
         ReplicatedHandData = InXRCoreHandData;
+        AddHandSample(InXRCoreHandData);
+        SetActorTickEnabled(true);
     }
 }
\ No newline at end of file
@@ -1,6 +1,9 @@
  
 #include "Core/XRCoreHandComponent.h"
+#include "Core/XRCoreStats.h"
 #include "Core/XRCoreHand.h"
+#include "Utilities/XRCoreNetStats.h"
+#include "Utilities/XRDebugRegistrySubsystem.h"
 
 #include "Engine/World.h"
 #include "GameFramework/Pawn.h"
@@ -17,13 +20,20 @@ UXRCoreHandComponent::UXRCoreHandComponent()
 void UXRCoreHandComponent::BeginPlay()
 {
 	Super::BeginPlay();
-	SetComponentTickInterval(ReplicationInterval);
+	UXRDebugRegistrySubsystem::Register<UXRCoreHandComponent>(this);
+	SetComponentTickInterval(bAdaptiveReplicationRate ? MinReplicationInterval : ReplicationInterval);
 
 	if (GetOwner()->HasAuthority())
 	{
 		Server_SpawnXRHand();
 	}
 }
+
+void UXRCoreHandComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UXRDebugRegistrySubsystem::Unregister<UXRCoreHandComponent>(this);
+	Super::EndPlay(EndPlayReason);
+}
 // ------------------------------------------------------------------------------------------------------------------------------------------------------------
 // Managed Hand Actor
 // ------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -50,6 +60,7 @@ void UXRCoreHandComponent::Server_SpawnXRHand_Implementation()
 	}
 	if (XRCoreHand)
 	{
+		XRCoreHand->HandReplicationMode = HandReplicationMode;
 		XRCoreHand->SetReplicates(true);
 	}
 
@@ -88,6 +99,11 @@ void UXRCoreHandComponent::OnRep_XRCoreHand()
 			XRCoreHand->AttachToComponent(this, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
 		}
 		PrimaryComponentTick.SetTickFunctionEnable(true);
+
+		if (bReplicateHandJoints && GetWorld()->GetNetMode() != NM_Standalone)
+		{
+			GetWorld()->GetTimerManager().SetTimer(HandJointTimer, this, &UXRCoreHandComponent::SendHandJoints, JointReplicationInterval, true);
+		}
 	}	
 
 }
@@ -99,23 +115,104 @@ void UXRCoreHandComponent::OnRep_XRCoreHand()
 // Tick only executes on the locally controlling client
 void UXRCoreHandComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
+	XRCORE_SCOPE_CYCLE_COUNTER(STAT_XRCore_HandSend);
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
 	if (bIsLocallyControlled)
 	{
-		FXRCoreHandReplicationData HandData;
-		HandData.Location = GetComponentLocation();
-		HandData.Rotation = GetComponentQuat();
-		HandData.PrimaryInputAxis = PrimaryInputAxisValue;
-		HandData.SecondaryInputAxis = SecondaryInputAxisValue;
+		const FVector Location = GetComponentLocation();
+		const FQuat Rotation = GetComponentQuat();
+		UpdateReplicationMetrics(DeltaTime, Location, Rotation);
+
+		if (!bAdaptiveReplicationRate || ShouldSendHandData(Location, Rotation))
+		{
+			SendHandData();
+		}
+	}
+}
+
+void UXRCoreHandComponent::SendHandData()
+{
+	FXRCoreHandReplicationData HandData;
+	HandData.Location = GetComponentLocation();
+	HandData.Rotation = GetComponentQuat();
+	HandData.PrimaryInputAxis = PrimaryInputAxisValue;
+	HandData.SecondaryInputAxis = SecondaryInputAxisValue;
+	HandData.Timestamp = GetWorld()->GetTimeSeconds();
+
+	Server_UpdateHandData(HandData);
+	XRCORE_RECORD_NET_MESSAGE(EXRNetFeature::HandData, FXRCoreNetStats::GetNetSerializedBytes(HandData), FXRCoreNetStats::GetNumServerReceivers(GetOwner()));
+	LastSentHandData = HandData;
+	ReplicationMetrics.NumSent++;
+}
+
+// Remotes hold the last sent pose, so send once it is off by more than the thresholds
+bool UXRCoreHandComponent::ShouldSendHandData(const FVector& InLocation, const FQuat& InRotation) const
+{
+	const double TimeSinceLastSend = GetWorld()->GetTimeSeconds() - LastSentHandData.Timestamp;
+	if (TimeSinceLastSend >= HeartbeatInterval)
+	{
+		return true;
+	}
+	if (TimeSinceLastSend < MinReplicationInterval)
+	{
+		return false;
+	}
+	return FVector::DistSquared(InLocation, LastSentHandData.Location) > FMath::Square(LocationSendThreshold)
+		|| FMath::RadiansToDegrees(InRotation.AngularDistance(LastSentHandData.Rotation)) > RotationSendThreshold;
+}
+
+void UXRCoreHandComponent::SendHandDataOnInputChange(float InAxisValue, float InLastSentAxisValue)
+{
+	if (bAdaptiveReplicationRate && FMath::Abs(InAxisValue - InLastSentAxisValue) >= InputAxisSendThreshold)
+	{
+		SendHandData();
+		ReplicationMetrics.NumInputSends++;
+	}
+}
 
-		Server_UpdateHandData(HandData);
+void UXRCoreHandComponent::UpdateReplicationMetrics(float InDeltaTime, const FVector& InLocation, const FQuat& InRotation)
+{
+	if (ReplicationMetrics.NumSent == 0)
+	{
+		return;
 	}
+	const float LocationError = FVector::Dist(InLocation, LastSentHandData.Location);
+	const float RotationError = FMath::RadiansToDegrees(InRotation.AngularDistance(LastSentHandData.Rotation));
+
+	ReplicationMetrics.Duration += InDeltaTime;
+	ReplicationMetrics.NumSamples++;
+	ReplicationMetrics.AverageLocationError += (LocationError - ReplicationMetrics.AverageLocationError) / ReplicationMetrics.NumSamples;
+	ReplicationMetrics.AverageRotationError += (RotationError - ReplicationMetrics.AverageRotationError) / ReplicationMetrics.NumSamples;
+	ReplicationMetrics.MaxLocationError = FMath::Max(ReplicationMetrics.MaxLocationError, LocationError);
+	ReplicationMetrics.MaxRotationError = FMath::Max(ReplicationMetrics.MaxRotationError, RotationError);
+}
+
+FXRHandReplicationMetrics UXRCoreHandComponent::GetReplicationMetrics() const
+{
+	FXRHandReplicationMetrics Metrics = ReplicationMetrics;
+	Metrics.SendRate = Metrics.Duration > 0.0f ? Metrics.NumSent / Metrics.Duration : 0.0f;
+	return Metrics;
+}
+
+void UXRCoreHandComponent::ResetReplicationMetrics()
+{
+	ReplicationMetrics = FXRHandReplicationMetrics();
 }
 
 void UXRCoreHandComponent::Server_UpdateHandData_Implementation(FXRCoreHandReplicationData InXRCoreHandData)
 {
+	if (HandReplicationMode == EXRHandReplicationMode::ReplicatedProperty)
+	{
+		if (XRCoreHand)
+		{
+			XRCoreHand->SetServerHandData(InXRCoreHandData);
+			XRCORE_RECORD_NET_MESSAGE(EXRNetFeature::HandData, FXRCoreNetStats::GetNetSerializedBytes(InXRCoreHandData), FXRCoreNetStats::GetNumClientReceivers(XRCoreHand, true));
+		}
+		return;
+	}
 	Multicast_UpdateHandData(InXRCoreHandData);
+	XRCORE_RECORD_NET_MESSAGE(EXRNetFeature::HandData, FXRCoreNetStats::GetNetSerializedBytes(InXRCoreHandData), FXRCoreNetStats::GetNumClientReceivers(GetOwner()));
 }
 
 void UXRCoreHandComponent::Multicast_UpdateHandData_Implementation(FXRCoreHandReplicationData InXRCoreHandData)
@@ -126,6 +223,113 @@ void UXRCoreHandComponent::Multicast_UpdateHandData_Implementation(FXRCoreHandRe
 	}
 }
 
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Joint Replication
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+void UXRCoreHandComponent::SetHandJointRotations(const TArray<FQuat>& InLocalRotations)
+{
+	if (!bIsLocallyControlled || InLocalRotations.Num() != XRHandJoints::NumJoints)
+	{
+		return;
+	}
+	PendingHandJoints = InLocalRotations;
+	bHasNewHandJoints = true;
+}
+
+void UXRCoreHandComponent::SendHandJoints()
+{
+	XRCORE_SCOPE_CYCLE_COUNTER(STAT_XRCore_HandSend);
+	if (!bHasNewHandJoints || !XRCoreHand || !IXRCoreHandInterface::Execute_IsHandtrackingActive(XRCoreHand))
+	{
+		return;
+	}
+	bHasNewHandJoints = false;
+
+	TArray<FQuat> RestPose;
+	XRCoreHand->GetHandJointRestPose(RestPose);
+	TArray<FXRQuantizedJointRotation> Frame;
+	FXRHandJointCodec::QuantizeFrame(PendingHandJoints, RestPose, JointRotationPrecision, Frame);
+
+	FXRHandJointPacket Packet;
+	Packet.FrameId = NextJointFrameId;
+	Packet.Precision = static_cast<uint8>(JointRotationPrecision);
+	NextJointFrameId = NextJointFrameId == MAX_uint16 ? 1 : NextJointFrameId + 1;
+
+	// Without an acknowledged frame in the history this is a full frame against the rest pose
+	const TArray<FXRQuantizedJointRotation>* Baseline = SentJointFrames.Find(LastAckedJointFrameId);
+	Packet.BaselineFrameId = Baseline ? LastAckedJointFrameId : 0;
+	FXRHandJointCodec::EncodeDelta(Frame, Baseline, Packet);
+
+	SentJointFrames.Add(Packet.FrameId, Frame);
+	Server_UpdateHandJoints(Packet);
+	XRCORE_RECORD_NET_MESSAGE(EXRNetFeature::HandJoints, (Packet.GetNumBits() + 7) / 8, FXRCoreNetStats::GetNumServerReceivers(GetOwner()));
+}
+
+void UXRCoreHandComponent::Server_UpdateHandJoints_Implementation(const FXRHandJointPacket& InPacket)
+{
+	// A newer frame already arrived, this one is of no use
+	if (LastReceivedJointFrameId != 0 && !XRHandJoints::IsNewerFrame(InPacket.FrameId, LastReceivedJointFrameId))
+	{
+		return;
+	}
+	const TArray<FXRQuantizedJointRotation>* Baseline = ReceivedJointFrames.Find(InPacket.BaselineFrameId);
+	if (InPacket.BaselineFrameId != 0 && !Baseline)
+	{
+		return;
+	}
+
+	TArray<FXRQuantizedJointRotation> Frame;
+	if (!FXRHandJointCodec::DecodeDelta(InPacket, Baseline, Frame))
+	{
+		return;
+	}
+	LastReceivedJointFrameId = InPacket.FrameId;
+	ReceivedJointFrames.Add(InPacket.FrameId, Frame);
+	Client_AckHandJoints(InPacket.FrameId);
+
+	// Other clients send no acks. The replicated property only delivers the latest value per connection and may skip a key frame,
+	// so it carries full frames; multicasts carry a key frame every JointKeyFrameInterval frames and deltas against it in between.
+	FXRHandJointPacket ForwardPacket;
+	if (HandReplicationMode == EXRHandReplicationMode::ReplicatedProperty)
+	{
+		ForwardPacket.FrameId = InPacket.FrameId;
+		ForwardPacket.Precision = InPacket.Precision;
+		FXRHandJointCodec::EncodeDelta(Frame, nullptr, ForwardPacket);
+	}
+	else
+	{
+		ForwardEncoder.Encode(InPacket.FrameId, InPacket.Precision, Frame, JointKeyFrameInterval, ForwardPacket);
+	}
+
+	if (HandReplicationMode == EXRHandReplicationMode::ReplicatedProperty)
+	{
+		if (XRCoreHand)
+		{
+			XRCoreHand->SetServerHandJoints(ForwardPacket);
+			XRCORE_RECORD_NET_MESSAGE(EXRNetFeature::HandJoints, (ForwardPacket.GetNumBits() + 7) / 8, FXRCoreNetStats::GetNumClientReceivers(XRCoreHand, true));
+		}
+		return;
+	}
+	Multicast_UpdateHandJoints(ForwardPacket);
+	XRCORE_RECORD_NET_MESSAGE(EXRNetFeature::HandJoints, (ForwardPacket.GetNumBits() + 7) / 8, FXRCoreNetStats::GetNumClientReceivers(GetOwner()));
+}
+
+void UXRCoreHandComponent::Client_AckHandJoints_Implementation(uint16 InFrameId)
+{
+	if (LastAckedJointFrameId == 0 || XRHandJoints::IsNewerFrame(InFrameId, LastAckedJointFrameId))
+	{
+		LastAckedJointFrameId = InFrameId;
+	}
+}
+
+void UXRCoreHandComponent::Multicast_UpdateHandJoints_Implementation(const FXRHandJointPacket& InPacket)
+{
+	if (XRCoreHand && !bIsLocallyControlled)
+	{
+		XRCoreHand->ApplyHandJointPacket(InPacket);
+	}
+}
+
 void UXRCoreHandComponent::GetLifetimeReplicatedProps(TArray< FLifetimeProperty >& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
@@ -169,6 +373,7 @@ void UXRCoreHandComponent::PrimaryInputAction_Implementation(float InAxisValue)
 	}
 	PrimaryInputAxisValue = InAxisValue;
 	IXRCoreHandInterface::Execute_PrimaryInputAction(XRCoreHand, InAxisValue);
+	SendHandDataOnInputChange(InAxisValue, LastSentHandData.PrimaryInputAxis);
 }
 
 void UXRCoreHandComponent::SecondaryInputAction_Implementation(float InAxisValue)
@@ -179,6 +384,7 @@ void UXRCoreHandComponent::SecondaryInputAction_Implementation(float InAxisValue
 	}
 	SecondaryInputAxisValue = InAxisValue;
 	IXRCoreHandInterface::Execute_SecondaryInputAction(XRCoreHand, InAxisValue);
+	SendHandDataOnInputChange(InAxisValue, LastSentHandData.SecondaryInputAxis);
 }
 
 void UXRCoreHandComponent::SetIsHandtrackingActive_Implementation(bool InIsActive)
@@ -10,6 +10,19 @@ UXRCoreSettings::UXRCoreSettings(const FObjectInitializer& ObjectInitializer)
 	DefaultHologramClass = TSoftClassPtr<AActor>(FSoftObjectPath(TEXT("/XRCore/Blueprints/BP_XRConnectorHologram")));
 }
 
+FXRReplicationProfile UXRCoreSettings::GetReplicationProfile(FName InProfileName) const
+{
+	if (const FXRReplicationProfile* FoundProfile = ReplicationProfiles.Find(InProfileName))
+	{
+		return *FoundProfile;
+	}
+
+	FXRReplicationProfile DefaultProfile;
+	DefaultProfile.ReplicationInterval = DefaultReplicationInterval;
+	DefaultProfile.InteractedReplicationInterval = InteractedReplicationInterval;
+	return DefaultProfile;
+}
+
 FName UXRCoreSettings::GetCategoryName() const
 {
 	return TEXT("Plugins");
@@ -0,0 +1,24 @@
+#include "Core/XRCoreStats.h"
+
+DEFINE_STAT(STAT_XRCore_InteractorOverlaps);
+DEFINE_STAT(STAT_XRCore_ConnectorOverlaps);
+DEFINE_STAT(STAT_XRCore_PriorityResolution);
+DEFINE_STAT(STAT_XRCore_Holograms);
+DEFINE_STAT(STAT_XRCore_Highlights);
+DEFINE_STAT(STAT_XRCore_PhysicsServerTick);
+DEFINE_STAT(STAT_XRCore_PhysicsClientTick);
+DEFINE_STAT(STAT_XRCore_HandSend);
+DEFINE_STAT(STAT_XRCore_HandPlayback);
+DEFINE_STAT(STAT_XRCore_LaserTargeting);
+DEFINE_STAT(STAT_XRCore_GrabFollow);
+DEFINE_STAT(STAT_XRCore_InteractableInstances);
+DEFINE_STAT(STAT_XRCore_InteractionEvents);
+DEFINE_STAT(STAT_XRCore_TriggerScheduler);
+
+DEFINE_STAT(STAT_XRCore_HandDataSends);
+DEFINE_STAT(STAT_XRCore_HandJointSends);
+DEFINE_STAT(STAT_XRCore_PhysicsSnapshots);
+DEFINE_STAT(STAT_XRCore_InteractionMulticasts);
+DEFINE_STAT(STAT_XRCore_LaserInputPackets);
+DEFINE_STAT(STAT_XRCore_TriggerStateChanges);
+DEFINE_STAT(STAT_XRCore_ConnectorStateChanges);
@@ -1,7 +1,13 @@
 
 #include "Core/XRLaserComponent.h"
+#include "Core/XRLaserTargetingSubsystem.h"
+#include "Interactions/XRInteractableInstances.h"
+#include "Interactions/XRInteractionComponent.h"
 #include "Interactions/XRInteractorComponent.h"
+#include "Utilities/XRCoreNetStats.h"
+#include "Utilities/XRToolsUtilityFunctions.h"
 
+#include "CollisionQueryParams.h"
 #include "Net/UnrealNetwork.h"
 #include "GameFramework/Actor.h"
 #include "Engine/World.h"
@@ -29,6 +35,30 @@ void UXRLaserComponent::BeginPlay()
 		bool SpawnResult = SpawnXRLaserActor();
 		OnXRLaserSpawned.Broadcast(this, SpawnResult);
 	}
+
+	// Targeting only matters where a player looks at the laser
+	if (bEnableNativeTargeting && NetMode != NM_DedicatedServer)
+	{
+		if (UXRLaserTargetingSubsystem* TargetingSubsystem = GetWorld()->GetSubsystem<UXRLaserTargetingSubsystem>())
+		{
+			TargetingSubsystem->RegisterLaser(this);
+		}
+	}
+}
+
+void UXRLaserComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UWorld* World = GetWorld();
+	if (UXRLaserTargetingSubsystem* TargetingSubsystem = World ? World->GetSubsystem<UXRLaserTargetingSubsystem>() : nullptr)
+	{
+		TargetingSubsystem->UnregisterLaser(this);
+	}
+	if (World)
+	{
+		World->GetTimerManager().ClearTimer(InputResendTimer);
+	}
+	LaserTarget = nullptr;
+	Super::EndPlay(EndPlayReason);
 }
 
 // ------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -89,48 +119,159 @@ UXRInteractorComponent* UXRLaserComponent::GetXRInteractor_Implementation() cons
 // ------------------------------------------------------------------------------------------------------------------------------------------------------------
 void UXRLaserComponent::StartInteractionByPriority_Implementation(int32 InPriority, EXRInteractionPrioritySelection InPrioritySelectionCondition)
 {
-	Server_RequestInteraction(0, InPriority, InPrioritySelectionCondition);
+	QueueInputCommand(EXRLaserInputCommand::StartInteraction, InPriority, InPrioritySelectionCondition);
 }
 
 void UXRLaserComponent::StopInteractionByPriority_Implementation(int32 InPriority, EXRInteractionPrioritySelection InPrioritySelectionCondition)
 {
-	Server_RequestInteraction(1, InPriority, InPrioritySelectionCondition);
+	QueueInputCommand(EXRLaserInputCommand::StopInteraction, InPriority, InPrioritySelectionCondition);
 }
 
 void UXRLaserComponent::StopAllInteractions_Implementation(UXRInteractorComponent* InInteractor)
 {
-	Server_RequestInteraction(2, 0, EXRInteractionPrioritySelection::Equal);
+	QueueInputCommand(EXRLaserInputCommand::StopAllInteractions, 0, EXRInteractionPrioritySelection::Equal);
 }
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
 
 
-void UXRLaserComponent::Server_RequestInteraction_Implementation(int32 InID, int32 InPriority, EXRInteractionPrioritySelection InPrioritySelectionCondition)
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Interaction Command Stream
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+namespace
 {
-	Multicast_RequestInteraction_Implementation(InID, InPriority, InPrioritySelectionCondition);
+	// Sequence numbers wrap around, A is covered by B if it is not newer
+	bool IsSequenceCoveredBy(uint16 InSequence, uint16 InCoveringSequence)
+	{
+		return static_cast<int16>(static_cast<uint16>(InSequence - InCoveringSequence)) <= 0;
+	}
 }
 
-void UXRLaserComponent::Multicast_RequestInteraction_Implementation(int32 InID, int32 InPriority, EXRInteractionPrioritySelection InPrioritySelectionCondition)
+bool FXRLaserInputPacket::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
 {
-	if (InID == 0)
+	Ar << BaseSequence;
+
+	uint32 NumCommands = FMath::Min(Commands.Num(), MaxCommands);
+	Ar.SerializeInt(NumCommands, MaxCommands + 1);
+	if (Ar.IsLoading())
 	{
-		if (XRLaserActor && XRLaserActor->GetClass()->ImplementsInterface(UXRInteractionInterface::StaticClass()))
-		{
-			IXRInteractionInterface::Execute_StartInteractionByPriority(XRLaserActor, InPriority, InPrioritySelectionCondition);
-		}
+		Commands.SetNum(NumCommands);
 	}
-	else if (InID == 1)
+
+	for (int32 Index = 0; Index < static_cast<int32>(NumCommands); Index++)
 	{
-		if (XRLaserActor && XRLaserActor->GetClass()->ImplementsInterface(UXRInteractionInterface::StaticClass()))
+		FXRLaserInputCommand& InputCommand = Commands[Index];
+
+		uint32 CommandValue = static_cast<uint32>(InputCommand.Command);
+		uint32 SelectionValue = static_cast<uint32>(InputCommand.PrioritySelection);
+		Ar.SerializeInt(CommandValue, 4);
+		Ar.SerializeInt(SelectionValue, 4);
+
+		// Zigzag, so small (and custom negative) priorities stay a single byte
+		uint32 PackedPriority = (static_cast<uint32>(InputCommand.Priority) << 1) ^ static_cast<uint32>(InputCommand.Priority >> 31);
+		Ar.SerializeIntPacked(PackedPriority);
+
+		if (Ar.IsLoading())
 		{
-			IXRInteractionInterface::Execute_StopInteractionByPriority(XRLaserActor, InPriority, InPrioritySelectionCondition);
+			InputCommand.Sequence = static_cast<uint16>(BaseSequence + Index);
+			InputCommand.Command = static_cast<EXRLaserInputCommand>(FMath::Min(CommandValue, static_cast<uint32>(EXRLaserInputCommand::StopAllInteractions)));
+			InputCommand.PrioritySelection = static_cast<EXRInteractionPrioritySelection>(FMath::Min(SelectionValue, static_cast<uint32>(EXRInteractionPrioritySelection::LowerEqual)));
+			InputCommand.Priority = static_cast<int32>(PackedPriority >> 1) ^ -static_cast<int32>(PackedPriority & 1);
 		}
+	}
 
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
+
+void UXRLaserComponent::QueueInputCommand(EXRLaserInputCommand InCommand, int32 InPriority, EXRInteractionPrioritySelection InPrioritySelectionCondition)
+{
+	// Server, ListenServer host and Standalone need no stream
+	if (GetOwnerRole() == ROLE_Authority)
+	{
+		ExecuteInputCommand(InCommand, InPriority, InPrioritySelectionCondition);
+		return;
+	}
+	// Only the owning client has a connection to send on and receives the acks
+	if (!GetOwner() || !GetOwner()->HasLocalNetOwner())
+	{
+		return;
+	}
+
+	FXRLaserInputCommand NewCommand;
+	NewCommand.Sequence = NextInputSequence++;
+	NewCommand.Command = InCommand;
+	NewCommand.Priority = InPriority;
+	NewCommand.PrioritySelection = InPrioritySelectionCondition;
+	PendingInputCommands.Add(NewCommand);
+
+	SendPendingInputCommands();
+	if (!GetWorld()->GetTimerManager().IsTimerActive(InputResendTimer))
+	{
+		GetWorld()->GetTimerManager().SetTimer(InputResendTimer, this, &UXRLaserComponent::SendPendingInputCommands, InputResendInterval, true);
+	}
+}
+
+// Always sends from the oldest unacknowledged command, several presses within one resend interval share a packet
+void UXRLaserComponent::SendPendingInputCommands()
+{
+	if (PendingInputCommands.Num() == 0)
+	{
+		GetWorld()->GetTimerManager().ClearTimer(InputResendTimer);
+		return;
 	}
-	else if (InID == 2)
+
+	FXRLaserInputPacket Packet;
+	Packet.BaseSequence = PendingInputCommands[0].Sequence;
+	Packet.Commands.Append(PendingInputCommands.GetData(), FMath::Min(PendingInputCommands.Num(), FXRLaserInputPacket::MaxCommands));
+	Server_SendInputPacket(Packet);
+	XRCORE_RECORD_NET_MESSAGE(EXRNetFeature::LaserInput, FXRCoreNetStats::GetNetSerializedBytes(Packet), FXRCoreNetStats::GetNumServerReceivers(GetOwner()));
+}
+
+void UXRLaserComponent::Server_SendInputPacket_Implementation(const FXRLaserInputPacket& InPacket)
+{
+	for (const FXRLaserInputCommand& InputCommand : InPacket.Commands)
 	{
-		if (XRLaserActor && XRLaserActor->GetClass()->ImplementsInterface(UXRInteractionInterface::StaticClass()))
+		// Resends of applied commands are skipped, nothing is applied past a missing sequence
+		if (InputCommand.Sequence != static_cast<uint16>(LastAppliedInputSequence + 1))
 		{
-			IXRInteractionInterface::Execute_StopAllInteractions(XRLaserActor, nullptr);
+			continue;
 		}
+		LastAppliedInputSequence = InputCommand.Sequence;
+		ExecuteInputCommand(InputCommand.Command, InputCommand.Priority, InputCommand.PrioritySelection);
+	}
+	Client_AckInputSequence(LastAppliedInputSequence);
+}
+
+void UXRLaserComponent::Client_AckInputSequence_Implementation(uint16 InSequence)
+{
+	PendingInputCommands.RemoveAll([InSequence](const FXRLaserInputCommand& InputCommand)
+	{
+		return IsSequenceCoveredBy(InputCommand.Sequence, InSequence);
+	});
+	if (PendingInputCommands.Num() == 0)
+	{
+		GetWorld()->GetTimerManager().ClearTimer(InputResendTimer);
+	}
+}
+
+void UXRLaserComponent::ExecuteInputCommand(EXRLaserInputCommand InCommand, int32 InPriority, EXRInteractionPrioritySelection InPrioritySelectionCondition)
+{
+	if (!XRLaserActor || !XRLaserActor->GetClass()->ImplementsInterface(UXRInteractionInterface::StaticClass()))
+	{
+		return;
+	}
+
+	switch (InCommand)
+	{
+	case EXRLaserInputCommand::StartInteraction:
+		IXRInteractionInterface::Execute_StartInteractionByPriority(XRLaserActor, InPriority, InPrioritySelectionCondition);
+		break;
+	case EXRLaserInputCommand::StopInteraction:
+		IXRInteractionInterface::Execute_StopInteractionByPriority(XRLaserActor, InPriority, InPrioritySelectionCondition);
+		break;
+	case EXRLaserInputCommand::StopAllInteractions:
+		IXRInteractionInterface::Execute_StopAllInteractions(XRLaserActor, nullptr);
+		break;
 	}
 }
 // ------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -172,6 +313,224 @@ bool UXRLaserComponent::SpawnXRLaserActor()
 }
 
 
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Targeting
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+UXRInteractionComponent* UXRLaserComponent::GetLaserTarget(FHitResult& OutHitResult) const
+{
+	OutHitResult = LaserTargetHit;
+	return LaserTarget.Get();
+}
+
+bool UXRLaserComponent::WantsTargetingTrace() const
+{
+	if (!bEnableNativeTargeting || !bIsLaserActive)
+	{
+		return false;
+	}
+	return bTargetOnRemoteLasers || IsLocallyControlled();
+}
+
+float UXRLaserComponent::GetTargetingInterval() const
+{
+	return IsLocallyControlled() ? LocalTargetingInterval : RemoteTargetingInterval;
+}
+
+FTraceHandle UXRLaserComponent::RequestTargetingTrace()
+{
+	UWorld* World = GetWorld();
+	AActor* Owner = GetOwner();
+	if (!World || !Owner)
+	{
+		return FTraceHandle();
+	}
+
+	const FVector TraceStart = GetComponentLocation();
+	const FVector TraceEnd = TraceStart + GetForwardVector() * TraceLength;
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(XRLaserTargeting), false, Owner);
+	if (Owner->GetOwner())
+	{
+		QueryParams.AddIgnoredActor(Owner->GetOwner());
+	}
+	if (XRLaserActor)
+	{
+		QueryParams.AddIgnoredActor(XRLaserActor);
+	}
+
+	if (TraceShape == EXRLaserTraceShape::Sphere && TraceRadius > 0.0f)
+	{
+		return World->AsyncSweepByChannel(EAsyncTraceType::Single, TraceStart, TraceEnd, FQuat::Identity, TraceChannel,
+			FCollisionShape::MakeSphere(TraceRadius), QueryParams);
+	}
+	return World->AsyncLineTraceByChannel(EAsyncTraceType::Single, TraceStart, TraceEnd, TraceChannel, QueryParams);
+}
+
+// Resolve the hit primitive to an XRInteraction the same way the XRInteractor does for overlaps
+void UXRLaserComponent::ProcessTargetingResult(const FTraceDatum& InTraceDatum)
+{
+	LaserTargetHit = FHitResult();
+	UXRInteractionComponent* NewTarget = nullptr;
+
+	// The promoted actor of the requested item went away, the instance shown again has to be requested anew
+	if (RequestedPromotionActor.IsStale())
+	{
+		RequestPromotion(nullptr, INDEX_NONE);
+	}
+
+	bool bTargetsRequestedItem = false;
+	if (InTraceDatum.OutHits.Num() > 0 && InTraceDatum.OutHits[0].bBlockingHit)
+	{
+		LaserTargetHit = InTraceDatum.OutHits[0];
+		UPrimitiveComponent* HitComponent = LaserTargetHit.GetComponent();
+		if (AXRInteractableInstances* InteractableInstances = Cast<AXRInteractableInstances>(LaserTargetHit.GetActor()))
+		{
+			HitComponent = ResolveInteractableInstance(InteractableInstances, LaserTargetHit.Item);
+			bTargetsRequestedItem = true;
+		}
+		else if (const AXRInteractableInstances* RequestedInstances = RequestedPromotionInstances.Get())
+		{
+			AActor* PromotedActor = RequestedInstances->GetPromotedActor(RequestedPromotionItem);
+			bTargetsRequestedItem = PromotedActor && LaserTargetHit.GetActor() == PromotedActor;
+			if (bTargetsRequestedItem)
+			{
+				RequestedPromotionActor = PromotedActor;
+			}
+		}
+		UXRInteractionComponent* PrioritizedInteraction = UXRToolsUtilityFunctions::GetXRInteractionByPriority(
+			UXRToolsUtilityFunctions::GetChildXRInteractions(HitComponent), GetXRInteractor_Implementation(), 0, EXRInteractionPrioritySelection::LowerEqual);
+		if (PrioritizedInteraction && PrioritizedInteraction->IsLaserInteractionEnabled())
+		{
+			NewTarget = PrioritizedInteraction;
+		}
+	}
+	if (!bTargetsRequestedItem)
+	{
+		RequestPromotion(nullptr, INDEX_NONE);
+	}
+	SetLaserTarget(NewTarget);
+}
+
+UPrimitiveComponent* UXRLaserComponent::ResolveInteractableInstance(AXRInteractableInstances* InInteractableInstances, int32 InInstanceIndex)
+{
+	const int32 Item = InInteractableInstances->GetItemForInstance(InInstanceIndex);
+	RequestPromotion(InInteractableInstances, Item);
+	if (Item == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	// Promoted right away with authority, clients trace the instance until the promoted actor has replicated
+	AActor* PromotedActor = InInteractableInstances->GetPromotedActor(Item);
+	if (PromotedActor)
+	{
+		RequestedPromotionActor = PromotedActor;
+	}
+	return PromotedActor ? Cast<UPrimitiveComponent>(PromotedActor->GetRootComponent()) : nullptr;
+}
+
+// Ask once per item, the server keeps the item promoted until the laser targets something else
+void UXRLaserComponent::RequestPromotion(AXRInteractableInstances* InInteractableInstances, int32 InItem)
+{
+	if (InItem == INDEX_NONE)
+	{
+		InInteractableInstances = nullptr;
+	}
+	if (!IsLocallyControlled() || (RequestedPromotionInstances == InInteractableInstances && RequestedPromotionItem == InItem))
+	{
+		return;
+	}
+	if (GetOwnerRole() == ROLE_Authority)
+	{
+		ApplyPromotionRequest(InInteractableInstances, InItem);
+		return;
+	}
+
+	RequestedPromotionInstances = InInteractableInstances;
+	RequestedPromotionItem = InItem;
+	RequestedPromotionActor = nullptr;
+	Server_RequestPromotion(InInteractableInstances, InItem);
+	// Actor reference as a net GUID plus the item index
+	XRCORE_RECORD_NET_MESSAGE_ESTIMATE(EXRNetFeature::LaserInput, sizeof(uint32) + sizeof(int32), FXRCoreNetStats::GetNumServerReceivers(GetOwner()));
+}
+
+void UXRLaserComponent::ApplyPromotionRequest(AXRInteractableInstances* InInteractableInstances, int32 InItem)
+{
+	if (AXRInteractableInstances* PreviousInstances = RequestedPromotionInstances.Get())
+	{
+		PreviousInstances->SetLaserTargetedItem(this, INDEX_NONE);
+	}
+	RequestedPromotionInstances = InInteractableInstances;
+	RequestedPromotionItem = InItem;
+	RequestedPromotionActor = nullptr;
+	if (InInteractableInstances)
+	{
+		InInteractableInstances->PromoteItem(InItem);
+		InInteractableInstances->SetLaserTargetedItem(this, InItem);
+	}
+}
+
+void UXRLaserComponent::Server_RequestPromotion_Implementation(AXRInteractableInstances* InInteractableInstances, int32 InItem)
+{
+	ApplyPromotionRequest(InInteractableInstances, InItem);
+}
+
+void UXRLaserComponent::ClearLaserTarget()
+{
+	LaserTargetHit = FHitResult();
+	RequestPromotion(nullptr, INDEX_NONE);
+	SetLaserTarget(nullptr);
+}
+
+void UXRLaserComponent::SetLaserTarget(UXRInteractionComponent* InTarget)
+{
+	UXRInteractionComponent* PreviousTarget = LaserTarget.Get();
+	if (PreviousTarget == InTarget)
+	{
+		return;
+	}
+	LaserTarget = InTarget;
+
+	if (XRLaserActor && XRLaserActor->GetClass()->ImplementsInterface(UXRInteractionInterface::StaticClass()))
+	{
+		UXRInteractorComponent* LaserInteractor = GetXRInteractor_Implementation();
+		if (PreviousTarget)
+		{
+			IXRInteractionInterface::Execute_HoverInteraction(XRLaserActor, LaserInteractor, PreviousTarget, false);
+		}
+		if (InTarget)
+		{
+			IXRInteractionInterface::Execute_HoverInteraction(XRLaserActor, LaserInteractor, InTarget, true);
+		}
+	}
+	OnXRLaserTargetChanged.Broadcast(this, InTarget);
+}
+
+bool UXRLaserComponent::IsLocallyControlled() const
+{
+	AActor* Owner = GetOwner();
+	if (!Owner)
+	{
+		return false;
+	}
+
+	APawn* OwningPawn = nullptr;
+	if (Owner->GetClass()->ImplementsInterface(UXRCoreHandInterface::StaticClass()))
+	{
+		OwningPawn = IXRCoreHandInterface::Execute_GetOwningPawn(Owner);
+	}
+	if (!OwningPawn)
+	{
+		OwningPawn = Cast<APawn>(Owner);
+	}
+	if (!OwningPawn)
+	{
+		OwningPawn = Cast<APawn>(Owner->GetOwner());
+	}
+	return OwningPawn && OwningPawn->IsLocallyControlled();
+}
+
+
 // ------------------------------------------------------------------------------------------------------------------------------------------------------------
 // Replication
 // ------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,157 @@
+#include "Core/XRLaserTargetingSubsystem.h"
+#include "Core/XRCoreStats.h"
+#include "Core/XRCoreSettings.h"
+#include "Core/XRLaserComponent.h"
+
+#include "Engine/World.h"
+
+bool UXRLaserTargetingSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UXRLaserTargetingSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UXRLaserTargetingSubsystem, STATGROUP_Tickables);
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Registration
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+void UXRLaserTargetingSubsystem::RegisterLaser(UXRLaserComponent* InLaser)
+{
+	if (!InLaser)
+	{
+		return;
+	}
+	for (const FXRLaserTargetingEntry& Entry : Entries)
+	{
+		if (Entry.Laser == InLaser)
+		{
+			return;
+		}
+	}
+
+	FXRLaserTargetingEntry NewEntry;
+	NewEntry.Laser = InLaser;
+	Entries.Add(NewEntry);
+}
+
+// Only invalidates the entry, so lasers can unregister while results are dispatched. Entries are compacted on the next Tick.
+void UXRLaserTargetingSubsystem::UnregisterLaser(UXRLaserComponent* InLaser)
+{
+	for (FXRLaserTargetingEntry& Entry : Entries)
+	{
+		if (Entry.Laser == InLaser)
+		{
+			Entry.Laser = nullptr;
+			Entry.PendingTrace.Invalidate();
+		}
+	}
+}
+
+FXRLaserTargetingStats UXRLaserTargetingSubsystem::GetTargetingStats() const
+{
+	return Stats;
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Batching
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+void UXRLaserTargetingSubsystem::Tick(float DeltaTime)
+{
+	XRCORE_SCOPE_CYCLE_COUNTER(STAT_XRCore_LaserTargeting);
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	Entries.RemoveAll([](const FXRLaserTargetingEntry& Entry) { return !Entry.Laser.IsValid(); });
+
+	Stats.NumRegisteredLasers = Entries.Num();
+	Stats.NumTracesLastFrame = 0;
+	Stats.NumDeferredLastFrame = 0;
+
+	DispatchCompletedTraces(World);
+	SubmitDueTraces(World);
+}
+
+// Results of the batch submitted last frame. Entries are accessed by index as dispatching can (un)register lasers.
+void UXRLaserTargetingSubsystem::DispatchCompletedTraces(UWorld* InWorld)
+{
+	for (int32 Index = 0; Index < Entries.Num(); Index++)
+	{
+		const FTraceHandle PendingTrace = Entries[Index].PendingTrace;
+		if (!PendingTrace.IsValid())
+		{
+			continue;
+		}
+
+		FTraceDatum TraceDatum;
+		if (InWorld->QueryTraceData(PendingTrace, TraceDatum))
+		{
+			Entries[Index].PendingTrace.Invalidate();
+			if (UXRLaserComponent* Laser = Entries[Index].Laser.Get())
+			{
+				Laser->ProcessTargetingResult(TraceDatum);
+			}
+		}
+		// Not ready yet, keep waiting unless the async trace buffer has already moved past this handle
+		else if (!InWorld->IsTraceHandleValid(PendingTrace, false))
+		{
+			Entries[Index].PendingTrace.Invalidate();
+		}
+	}
+}
+
+void UXRLaserTargetingSubsystem::SubmitDueTraces(UWorld* InWorld)
+{
+	const double Now = InWorld->GetTimeSeconds();
+	const int32 MaxTracesPerFrame = GetDefault<UXRCoreSettings>()->MaxLaserTracesPerFrame;
+
+	TArray<int32, TInlineAllocator<16>> DueEntries;
+	for (int32 Index = 0; Index < Entries.Num(); Index++)
+	{
+		UXRLaserComponent* Laser = Entries[Index].Laser.Get();
+		if (!Laser || Entries[Index].PendingTrace.IsValid())
+		{
+			continue;
+		}
+		if (!Laser->WantsTargetingTrace())
+		{
+			Laser->ClearLaserTarget();
+			continue;
+		}
+		if (Entries[Index].NextTraceTime <= Now)
+		{
+			DueEntries.Add(Index);
+		}
+	}
+
+	// Most overdue first, so a trace budget never starves the same lasers
+	DueEntries.Sort([this](int32 A, int32 B) { return Entries[A].NextTraceTime < Entries[B].NextTraceTime; });
+
+	for (int32 EntryIndex : DueEntries)
+	{
+		if (MaxTracesPerFrame > 0 && Stats.NumTracesLastFrame >= MaxTracesPerFrame)
+		{
+			Stats.NumDeferredLastFrame++;
+			continue;
+		}
+
+		UXRLaserComponent* Laser = Entries[EntryIndex].Laser.Get();
+		if (!Laser)
+		{
+			continue;
+		}
+		const FTraceHandle NewTrace = Laser->RequestTargetingTrace();
+		Entries[EntryIndex].PendingTrace = NewTrace;
+		Entries[EntryIndex].NextTraceTime = Now + Laser->GetTargetingInterval();
+		if (NewTrace.IsValid())
+		{
+			Stats.NumTracesLastFrame++;
+			Stats.TotalTraces++;
+		}
+	}
+}
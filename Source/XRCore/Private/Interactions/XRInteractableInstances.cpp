@@ -0,0 +1,402 @@
+#include "Interactions/XRInteractableInstances.h"
+#include "Core/XRCoreStats.h"
+#include "Interactions/XRInteractorComponent.h"
+#include "Interactions/XRInteractorSubsystem.h"
+#include "Utilities/XRDebugRegistrySubsystem.h"
+#include "Utilities/XRToolsUtilityFunctions.h"
+
+#include "Engine/CollisionProfile.h"
+#include "Engine/World.h"
+#include "Net/UnrealNetwork.h"
+
+AXRInteractableInstances::AXRInteractableInstances()
+{
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = true;
+	bReplicates = true;
+	// Items are spread over the whole scene, their few promoted states are cheap to send to everyone
+	bAlwaysRelevant = true;
+	ItemStates.Owner = this;
+
+	Instances = CreateDefaultSubobject<UHierarchicalInstancedStaticMeshComponent>(TEXT("Instances"));
+	Instances->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+	// Promotion is driven by distance queries, overlap events on thousands of instances would only cost time
+	Instances->SetGenerateOverlapEvents(false);
+	RootComponent = Instances;
+}
+
+void AXRInteractableInstances::BeginPlay()
+{
+	Super::BeginPlay();
+	UXRDebugRegistrySubsystem::Register<AXRInteractableInstances>(this);
+
+	// Authored instances are identical on server and clients, so their indices are the item indices everywhere
+	const int32 NumInstances = Instances->GetInstanceCount();
+	Items.SetNum(NumInstances);
+	InstanceToItem.SetNum(NumInstances);
+	for (int32 InstanceIndex = 0; InstanceIndex < NumInstances; ++InstanceIndex)
+	{
+		Instances->GetInstanceTransform(InstanceIndex, Items[InstanceIndex].Transform, true);
+		Items[InstanceIndex].InstanceIndex = InstanceIndex;
+		InstanceToItem[InstanceIndex] = InstanceIndex;
+	}
+
+	if (HasAuthority())
+	{
+		SetActorTickInterval(UpdateInterval);
+	}
+	else
+	{
+		SetActorTickEnabled(false);
+		// States that arrived before the authored items existed
+		for (const FXRInteractableInstanceState& State : ItemStates.States)
+		{
+			ApplyItemState(State);
+		}
+	}
+}
+
+void AXRInteractableInstances::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UXRDebugRegistrySubsystem::Unregister<AXRInteractableInstances>(this);
+	Super::EndPlay(EndPlayReason);
+}
+
+void AXRInteractableInstances::Tick(float DeltaSeconds)
+{
+	XRCORE_SCOPE_CYCLE_COUNTER(STAT_XRCore_InteractableInstances);
+	Super::Tick(DeltaSeconds);
+
+	if (!HasAuthority())
+	{
+		return;
+	}
+
+	TArray<FVector> InteractorLocations;
+	if (const UXRInteractorSubsystem* InteractorSubsystem = GetWorld()->GetSubsystem<UXRInteractorSubsystem>())
+	{
+		for (const TWeakObjectPtr<UXRInteractorComponent>& Interactor : InteractorSubsystem->GetInteractors())
+		{
+			if (Interactor.IsValid())
+			{
+				InteractorLocations.Add(Interactor->GetComponentLocation());
+			}
+		}
+	}
+
+	// Lasers that went away without clearing their target
+	for (auto It = LaserTargetedItems.CreateIterator(); It; ++It)
+	{
+		if (!It->Key.IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	// Collect first, promoting swaps instances around
+	TArray<int32> ItemsToPromote;
+	for (const FVector& InteractorLocation : InteractorLocations)
+	{
+		for (int32 InstanceIndex : Instances->GetInstancesOverlappingSphere(InteractorLocation, PromotionRadius, true))
+		{
+			const int32 Item = GetItemForInstance(InstanceIndex);
+			if (Item != INDEX_NONE)
+			{
+				ItemsToPromote.AddUnique(Item);
+			}
+		}
+	}
+	for (int32 Item : ItemsToPromote)
+	{
+		PromoteItem(Item);
+	}
+
+	for (int32 PromotedIndex = PromotedItems.Num() - 1; PromotedIndex >= 0; --PromotedIndex)
+	{
+		const int32 Item = PromotedItems[PromotedIndex];
+		FXRInteractableItem& PromotedItem = Items[Item];
+		AActor* PromotedActor = PromotedItem.PromotedActor.Get();
+		if (!PromotedActor)
+		{
+			// Destroyed by gameplay, the item stays gone
+			PromotedItems.RemoveAtSwap(PromotedIndex);
+			continue;
+		}
+
+		// Wider range for demotion, so items at the edge don't flip every update
+		TArray<UXRInteractionComponent*> ActiveInteractions;
+		const bool bInUse = IsInPromotionRange(PromotedActor->GetActorLocation(), InteractorLocations, 1.5f)
+			|| IsLaserTargeted(Item)
+			|| UXRToolsUtilityFunctions::IsActorInteractedWith(PromotedActor, ActiveInteractions)
+			|| PromotedActor->GetAttachParentActor() != nullptr
+			|| !PromotedActor->GetVelocity().IsNearlyZero(1.0f);
+		PromotedItem.RestTime = bInUse ? 0.0f : PromotedItem.RestTime + DeltaSeconds;
+		if (PromotedItem.RestTime >= DemotionDelay)
+		{
+			DemoteItem(Item);
+		}
+	}
+}
+
+bool AXRInteractableInstances::IsLaserTargeted(int32 InItem) const
+{
+	for (const TPair<TWeakObjectPtr<const UXRLaserComponent>, int32>& LaserTarget : LaserTargetedItems)
+	{
+		if (LaserTarget.Value == InItem)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool AXRInteractableInstances::IsInPromotionRange(const FVector& InLocation, const TArray<FVector>& InInteractorLocations, float InRadiusScale) const
+{
+	const float RadiusSquared = FMath::Square(PromotionRadius * InRadiusScale);
+	for (const FVector& InteractorLocation : InInteractorLocations)
+	{
+		if (FVector::DistSquared(InLocation, InteractorLocation) <= RadiusSquared)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Items
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+int32 AXRInteractableInstances::AddItem(const FTransform& InTransform)
+{
+	// Before BeginPlay (e.g. construction script) the instance becomes an item like an authored one
+	if (!HasActorBegunPlay())
+	{
+		return Instances->AddInstance(InTransform, true);
+	}
+	if (!HasAuthority())
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 Item = Items.AddDefaulted();
+	Items[Item].Transform = InTransform;
+	ShowInstance(Item);
+	SetItemState(Item, false);
+	return Item;
+}
+
+AActor* AXRInteractableInstances::PromoteItem(int32 InItem)
+{
+	if (!HasAuthority() || !Items.IsValidIndex(InItem) || !PromotedActorClass)
+	{
+		return nullptr;
+	}
+	FXRInteractableItem& Item = Items[InItem];
+	if (Item.PromotedActor.IsValid())
+	{
+		return Item.PromotedActor.Get();
+	}
+	if (Item.InstanceIndex == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	AActor* PromotedActor = GetWorld()->SpawnActor<AActor>(PromotedActorClass, Item.Transform, SpawnParameters);
+	if (!PromotedActor)
+	{
+		return nullptr;
+	}
+
+	HideInstance(InItem);
+	Item.PromotedActor = PromotedActor;
+	Item.RestTime = 0.0f;
+	PromotedItems.Add(InItem);
+	SetItemState(InItem, true);
+	return PromotedActor;
+}
+
+bool AXRInteractableInstances::DemoteItem(int32 InItem)
+{
+	if (!HasAuthority() || !Items.IsValidIndex(InItem))
+	{
+		return false;
+	}
+	FXRInteractableItem& Item = Items[InItem];
+	AActor* PromotedActor = Item.PromotedActor.Get();
+	if (!PromotedActor)
+	{
+		return false;
+	}
+
+	Item.Transform = PromotedActor->GetActorTransform();
+	Item.PromotedActor = nullptr;
+	PromotedActor->Destroy();
+	PromotedItems.Remove(InItem);
+
+	ShowInstance(InItem);
+	SetItemState(InItem, false);
+	return true;
+}
+
+int32 AXRInteractableInstances::GetItemForInstance(int32 InInstanceIndex) const
+{
+	return InstanceToItem.IsValidIndex(InInstanceIndex) ? InstanceToItem[InInstanceIndex] : INDEX_NONE;
+}
+
+AActor* AXRInteractableInstances::GetPromotedActor(int32 InItem) const
+{
+	return Items.IsValidIndex(InItem) ? Items[InItem].PromotedActor.Get() : nullptr;
+}
+
+void AXRInteractableInstances::SetLaserTargetedItem(const UXRLaserComponent* InLaser, int32 InItem)
+{
+	if (!HasAuthority() || !InLaser)
+	{
+		return;
+	}
+	if (Items.IsValidIndex(InItem))
+	{
+		LaserTargetedItems.Add(InLaser, InItem);
+	}
+	else
+	{
+		LaserTargetedItems.Remove(InLaser);
+	}
+}
+
+int32 AXRInteractableInstances::GetNumItems() const
+{
+	return Items.Num();
+}
+
+int32 AXRInteractableInstances::GetNumPromotedItems() const
+{
+	return PromotedItems.Num();
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Instances
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+void AXRInteractableInstances::ShowInstance(int32 InItem)
+{
+	FXRInteractableItem& Item = Items[InItem];
+	if (Item.InstanceIndex != INDEX_NONE)
+	{
+		return;
+	}
+	Item.InstanceIndex = Instances->AddInstance(Item.Transform, true);
+	InstanceToItem.SetNum(FMath::Max(InstanceToItem.Num(), Item.InstanceIndex + 1));
+	InstanceToItem[Item.InstanceIndex] = InItem;
+}
+
+void AXRInteractableInstances::HideInstance(int32 InItem)
+{
+	FXRInteractableItem& Item = Items[InItem];
+	const int32 InstanceIndex = Item.InstanceIndex;
+	if (InstanceIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	// The HISM moves its last instance into the removed slot, mirror that in the lookup
+	const int32 LastInstanceIndex = InstanceToItem.Num() - 1;
+	Instances->RemoveInstance(InstanceIndex);
+	InstanceToItem.RemoveAtSwap(InstanceIndex);
+	if (InstanceIndex != LastInstanceIndex)
+	{
+		Items[InstanceToItem[InstanceIndex]].InstanceIndex = InstanceIndex;
+	}
+	Item.InstanceIndex = INDEX_NONE;
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Replication
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+void AXRInteractableInstances::SetItemState(int32 InItem, bool bInPromoted)
+{
+	int32& StateIndex = ItemToStateIndex.FindOrAdd(InItem, INDEX_NONE);
+	if (StateIndex == INDEX_NONE)
+	{
+		StateIndex = ItemStates.States.AddDefaulted();
+		ItemStates.States[StateIndex].Item = InItem;
+	}
+	FXRInteractableInstanceState& State = ItemStates.States[StateIndex];
+	State.bPromoted = bInPromoted;
+	State.Transform = Items[InItem].Transform;
+	State.PromotedActor = Items[InItem].PromotedActor;
+	ItemStates.MarkItemDirty(State);
+}
+
+void AXRInteractableInstances::ApplyItemState(const FXRInteractableInstanceState& InState)
+{
+	// BeginPlay applies the states once the authored items exist
+	if (!HasActorBegunPlay() || InState.Item < 0)
+	{
+		return;
+	}
+	// Items added on the server at runtime
+	if (InState.Item >= Items.Num())
+	{
+		Items.SetNum(InState.Item + 1);
+	}
+
+	FXRInteractableItem& Item = Items[InState.Item];
+	const bool bTransformChanged = !Item.Transform.Equals(InState.Transform);
+	Item.Transform = InState.Transform;
+	Item.PromotedActor = InState.PromotedActor;
+	// This actor is always relevant, the promoted actor is not. Until it exists here the instance stays visible in its place,
+	// the fast array calls PostReplicatedChange again once the actor reference maps.
+	if (InState.bPromoted && Item.PromotedActor.IsValid())
+	{
+		HideInstance(InState.Item);
+		Item.PromotedActor->OnDestroyed.AddUniqueDynamic(this, &AXRInteractableInstances::OnPromotedActorDestroyed);
+	}
+	else if (Item.InstanceIndex == INDEX_NONE)
+	{
+		ShowInstance(InState.Item);
+	}
+	else if (bTransformChanged)
+	{
+		Instances->UpdateInstanceTransform(Item.InstanceIndex, Item.Transform, true, true, true);
+	}
+}
+
+void AXRInteractableInstances::OnPromotedActorDestroyed(AActor* InDestroyedActor)
+{
+	if (HasAuthority())
+	{
+		return;
+	}
+	for (int32 ItemIndex = 0; ItemIndex < Items.Num(); ++ItemIndex)
+	{
+		if (Items[ItemIndex].PromotedActor.Get() == InDestroyedActor)
+		{
+			Items[ItemIndex].PromotedActor = nullptr;
+			ShowInstance(ItemIndex);
+		}
+	}
+}
+
+void FXRInteractableInstanceState::PostReplicatedAdd(const FXRInteractableInstanceStateArray& InArraySerializer)
+{
+	if (InArraySerializer.Owner)
+	{
+		InArraySerializer.Owner->ApplyItemState(*this);
+	}
+}
+
+void FXRInteractableInstanceState::PostReplicatedChange(const FXRInteractableInstanceStateArray& InArraySerializer)
+{
+	if (InArraySerializer.Owner)
+	{
+		InArraySerializer.Owner->ApplyItemState(*this);
+	}
+}
+
+void AXRInteractableInstances::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+	DOREPLIFETIME(AXRInteractableInstances, ItemStates);
+}
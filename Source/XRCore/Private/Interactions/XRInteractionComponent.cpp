@@ -1,12 +1,16 @@
 
 #include "Interactions/XRInteractionComponent.h"
+#include "Core/XRCoreSettings.h"
+#include "Interactions/XRInteractionEventSubsystem.h"
 #include "Interactions/XRInteractionTypes.h"
 #include "Interactions/XRInteractorComponent.h"
+#include "Utilities/XRAudioPoolSubsystem.h"
+#include "Utilities/XRDebugRegistrySubsystem.h"
 #include "Utilities/XRHighlightComponent.h"
 
 #include "Components/AudioComponent.h"
+#include "Engine/World.h"
 #include "GameFramework/GameSession.h"
-#include "Kismet/GameplayStatics.h"
 
 // ------------------------------------------------------------------------------------------------------------------------------------------------------------
 UXRInteractionComponent::UXRInteractionComponent()
@@ -44,21 +48,30 @@ void UXRInteractionComponent::InitializeComponent()
 void UXRInteractionComponent::BeginPlay()
 {
 	Super::BeginPlay();
-	if (bEnableHighlighting)
+	UXRDebugRegistrySubsystem::Register<UXRInteractionComponent>(this);
+	if (bEnableHighlighting && !GetDefault<UXRCoreSettings>()->bLazyHighlightCreation)
 	{
 		SpawnAndConfigureXRHighlight();
 	}
 }
 
+void UXRInteractionComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UXRDebugRegistrySubsystem::Unregister<UXRInteractionComponent>(this);
+	Super::EndPlay(EndPlayReason);
+}
+
 // ------------------------------------------------------------------------------------------------------------------------------------------------------------
 // Interaction Events
 // ------------------------------------------------------------------------------------------------------------------------------------------------------------
 void UXRInteractionComponent::StartInteraction(UXRInteractorComponent* InInteractor)
 {
-	ActiveInteractors.AddUnique(TWeakObjectPtr<UXRInteractorComponent>(InInteractor));
+	ActiveInteractors.Add(TWeakObjectPtr<UXRInteractorComponent>(InInteractor));
 	HoveringInteractors.Remove(TWeakObjectPtr<UXRInteractorComponent>(InInteractor));
+	FlushOwnerNetDormancy();
 	OnInteractionStart(InInteractor);
-	OnInteractionStarted.Broadcast(this, InInteractor);
+	OnInteractionStartedNative.Broadcast(this, InInteractor);
+	UXRInteractionEventSubsystem::Post(this, EXRInteractionEvent::InteractionStarted, InInteractor, this);
 	RequestAudioPlay(InteractionStartSound);
 	if (XRHighlightComponent)
 	{
@@ -69,10 +82,22 @@ void UXRInteractionComponent::StartInteraction(UXRInteractorComponent* InInterac
 void UXRInteractionComponent::EndInteraction(UXRInteractorComponent* InInteractor)
 {
 	ActiveInteractors.Remove(TWeakObjectPtr<UXRInteractorComponent>(InInteractor));
-	OnInteractionEnded.Broadcast(this, InInteractor);
+	FlushOwnerNetDormancy();
+	OnInteractionEndedNative.Broadcast(this, InInteractor);
+	UXRInteractionEventSubsystem::Post(this, EXRInteractionEvent::InteractionEnded, InInteractor, this);
 	RequestAudioPlay(InteractionEndSound);
 }
 
+// The owner is dormant while its XRReplicatedPhysicsComponent rests, interaction state changes would not reach the clients until it moves
+void UXRInteractionComponent::FlushOwnerNetDormancy()
+{
+	AActor* Owner = GetOwner();
+	if (Owner && Owner->HasAuthority() && Owner->NetDormancy > DORM_Awake)
+	{
+		Owner->FlushNetDormancy();
+	}
+}
+
 void UXRInteractionComponent::HoverInteraction(UXRInteractorComponent* InInteractor, bool bInHoverState)
 {
 	if (!InInteractor)
@@ -81,26 +106,28 @@ void UXRInteractionComponent::HoverInteraction(UXRInteractorComponent* InInterac
 	}
 	if (bInHoverState)
 	{	
-		TArray<UXRInteractorComponent*> CurrentHoveringInteractors = {};
-		if (!IsHovered(CurrentHoveringInteractors))
+		if (NumHoveringInteractors() == 0)
 		{
 			OnInteractionHover(true, InInteractor);
-			OnInteractionHovered.Broadcast(this, InInteractor, true);
+			UXRInteractionEventSubsystem::Post(this, EXRInteractionEvent::InteractionHover, InInteractor, this, true);
+			if (bEnableHighlighting && !XRHighlightComponent)
+			{
+				SpawnAndConfigureXRHighlight();
+			}
 			if (XRHighlightComponent)
 			{
 				XRHighlightComponent->FadeXRHighlight(true);
 			}
 		}
-		HoveringInteractors.AddUnique(TWeakObjectPtr<UXRInteractorComponent>(InInteractor));
+		HoveringInteractors.Add(TWeakObjectPtr<UXRInteractorComponent>(InInteractor));
 	}
 	if (!bInHoverState)
 	{
 		HoveringInteractors.Remove(TWeakObjectPtr<UXRInteractorComponent>(InInteractor));
-		TArray<UXRInteractorComponent*> CurrentHoveringInteractors = {};
-		if (!IsHovered(CurrentHoveringInteractors))
+		if (NumHoveringInteractors() == 0)
 		{
 			OnInteractionHover(false, InInteractor);
-			OnInteractionHovered.Broadcast(this, InInteractor, false);
+			UXRInteractionEventSubsystem::Post(this, EXRInteractionEvent::InteractionHover, InInteractor, this, false);
 			if (XRHighlightComponent)
 			{
 				XRHighlightComponent->FadeXRHighlight(false);
@@ -123,6 +150,19 @@ bool UXRInteractionComponent::IsHovered(TArray<UXRInteractorComponent*>& OutHove
 	return OutHoveringInteractors.Num() > 0;
 }
 
+int32 UXRInteractionComponent::NumHoveringInteractors() const
+{
+	int32 NumInteractors = 0;
+	for (const TWeakObjectPtr<UXRInteractorComponent>& HoveringInteractor : HoveringInteractors)
+	{
+		if (HoveringInteractor.IsValid())
+		{
+			NumInteractors++;
+		}
+	}
+	return NumInteractors;
+}
+
 // ------------------------------------------------------------------------------------------------------------------------------------------------------------
 // Highlighting & Audio
 // ------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -133,6 +173,12 @@ void UXRInteractionComponent::SpawnAndConfigureXRHighlight()
 		return;
 	}
 
+	// Highlighting is purely visual
+	if (GetNetMode() == NM_DedicatedServer)
+	{
+		return;
+	}
+
 	AActor* Owner = GetOwner();
 	if (!Owner)
 	{
@@ -158,15 +204,15 @@ UXRHighlightComponent* UXRInteractionComponent::GetXRHighlightComponent()
 
 void UXRInteractionComponent::RequestAudioPlay(USoundBase* InSound)
 {
-	if (CurrentAudioComponent && CurrentAudioComponent->IsPlaying())
+	UWorld* World = GetWorld();
+	UXRAudioPoolSubsystem* AudioPool = World ? World->GetSubsystem<UXRAudioPoolSubsystem>() : nullptr;
+	if (!AudioPool)
 	{
-		CurrentAudioComponent->Stop();
+		return;
 	}
 
-	if (InSound)
-	{
-		CurrentAudioComponent = UGameplayStatics::SpawnSoundAtLocation(this, InSound, this->GetComponentLocation());
-	}
+	AudioPool->StopVoice(CurrentAudioVoice);
+	CurrentAudioVoice = AudioPool->PlaySoundAtLocation(InSound, this->GetComponentLocation());
 }
 
 // ------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -207,6 +253,48 @@ TArray<UXRInteractorComponent*> UXRInteractionComponent::GetActiveInteractors()
 	return OutInteractors;
 }
 
+int32 UXRInteractionComponent::NumActiveInteractors() const
+{
+	int32 NumInteractors = 0;
+	for (const TWeakObjectPtr<UXRInteractorComponent>& Interactor : ActiveInteractors)
+	{
+		if (Interactor.IsValid())
+		{
+			NumInteractors++;
+		}
+	}
+	return NumInteractors;
+}
+
+void UXRInteractionComponent::CopyActiveInteractors(FXRInteractorArray& OutInteractors) const
+{
+	OutInteractors.Reset();
+	for (const TWeakObjectPtr<UXRInteractorComponent>& Interactor : ActiveInteractors)
+	{
+		if (Interactor.IsValid())
+		{
+			OutInteractors.Add(Interactor.Get());
+		}
+	}
+}
+
+UXRInteractorComponent* UXRInteractionComponent::GetFirstActiveInteractor() const
+{
+	for (const TWeakObjectPtr<UXRInteractorComponent>& Interactor : ActiveInteractors)
+	{
+		if (Interactor.IsValid())
+		{
+			return Interactor.Get();
+		}
+	}
+	return nullptr;
+}
+
+bool UXRInteractionComponent::IsInteractedWithBy(const UXRInteractorComponent* InInteractor) const
+{
+	return InInteractor && ActiveInteractors.Contains(TWeakObjectPtr<UXRInteractorComponent>(const_cast<UXRInteractorComponent*>(InInteractor)));
+}
+
 
 EXRMultiInteractorBehavior UXRInteractionComponent::GetMultiInteractorBehavior() const
 {
@@ -216,7 +304,7 @@ EXRMultiInteractorBehavior UXRInteractionComponent::GetMultiInteractorBehavior()
 
 bool UXRInteractionComponent::IsInteractedWith() const
 {
-	return GetActiveInteractors().Num() > 0;
+	return NumActiveInteractors() > 0;
 }
 
 EXRLaserBehavior UXRInteractionComponent::GetLaserBehavior() const
@@ -0,0 +1,149 @@
+#include "Interactions/XRInteractionEventSubsystem.h"
+#include "Core/XRCoreSettings.h"
+#include "Core/XRCoreStats.h"
+#include "Interactions/XRInteractionComponent.h"
+#include "Interactions/XRInteractorComponent.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+void UXRInteractionEventSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	bDeferEvents = GetDefault<UXRCoreSettings>()->bDeferInteractionEvents;
+}
+
+bool UXRInteractionEventSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UXRInteractionEventSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UXRInteractionEventSubsystem, STATGROUP_Tickables);
+}
+
+void UXRInteractionEventSubsystem::Tick(float DeltaTime)
+{
+	Flush();
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Queue
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+void UXRInteractionEventSubsystem::Post(const UObject* InWorldContext, EXRInteractionEvent InEvent, UXRInteractorComponent* InInteractor, UXRInteractionComponent* InInteraction, bool bInState)
+{
+	FXRQueuedInteractionEvent QueuedEvent;
+	QueuedEvent.Event = InEvent;
+	QueuedEvent.Interactor = InInteractor;
+	QueuedEvent.Interaction = InInteraction;
+	QueuedEvent.bState = bInState;
+
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(InWorldContext, EGetWorldErrorMode::ReturnNull) : nullptr;
+	UXRInteractionEventSubsystem* EventSubsystem = World ? World->GetSubsystem<UXRInteractionEventSubsystem>() : nullptr;
+	if (EventSubsystem && EventSubsystem->bDeferEvents)
+	{
+		EventSubsystem->Enqueue(QueuedEvent);
+	}
+	else
+	{
+		Broadcast(QueuedEvent);
+	}
+}
+
+void UXRInteractionEventSubsystem::Enqueue(const FXRQueuedInteractionEvent& InEvent)
+{
+	if (IsHoverEvent(InEvent.Event))
+	{
+		// Only the latest queued hover of this pair matters: the same state is a duplicate, the opposite one cancels out
+		for (int32 EventIndex = QueuedEvents.Num() - 1; EventIndex >= 0; --EventIndex)
+		{
+			const FXRQueuedInteractionEvent& QueuedEvent = QueuedEvents[EventIndex];
+			if (QueuedEvent.Event == InEvent.Event && QueuedEvent.Interactor == InEvent.Interactor && QueuedEvent.Interaction == InEvent.Interaction)
+			{
+				if (QueuedEvent.bState != InEvent.bState)
+				{
+					QueuedEvents.RemoveAt(EventIndex);
+				}
+				return;
+			}
+		}
+	}
+	QueuedEvents.Add(InEvent);
+}
+
+void UXRInteractionEventSubsystem::Flush()
+{
+	if (QueuedEvents.Num() == 0)
+	{
+		return;
+	}
+	XRCORE_SCOPE_CYCLE_COUNTER(STAT_XRCore_InteractionEvents);
+
+	// Listeners may post new events while we dispatch
+	Swap(QueuedEvents, DispatchingEvents);
+	for (const FXRQueuedInteractionEvent& QueuedEvent : DispatchingEvents)
+	{
+		Broadcast(QueuedEvent);
+	}
+	DispatchingEvents.Reset();
+}
+
+int32 UXRInteractionEventSubsystem::GetNumQueuedEvents() const
+{
+	return QueuedEvents.Num();
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Dispatch
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool UXRInteractionEventSubsystem::IsHoverEvent(EXRInteractionEvent InEvent)
+{
+	return InEvent == EXRInteractionEvent::InteractorHover || InEvent == EXRInteractionEvent::InteractionHover;
+}
+
+void UXRInteractionEventSubsystem::Broadcast(const FXRQueuedInteractionEvent& InEvent)
+{
+	UXRInteractorComponent* Interactor = InEvent.Interactor.Get();
+	UXRInteractionComponent* Interaction = InEvent.Interaction.Get();
+
+	switch (InEvent.Event)
+	{
+		case EXRInteractionEvent::InteractorHover:
+			if (Interactor)
+			{
+				Interactor->OnHoverStateChanged.Broadcast(Interactor, Interaction, InEvent.bState);
+			}
+			break;
+		case EXRInteractionEvent::InteractorStarted:
+			if (Interactor)
+			{
+				Interactor->OnStartedInteracting.Broadcast(Interactor, Interaction);
+			}
+			break;
+		case EXRInteractionEvent::InteractorStopped:
+			if (Interactor)
+			{
+				Interactor->OnStoppedInteracting.Broadcast(Interactor, Interaction);
+			}
+			break;
+		case EXRInteractionEvent::InteractionHover:
+			if (Interaction)
+			{
+				Interaction->OnInteractionHovered.Broadcast(Interaction, Interactor, InEvent.bState);
+			}
+			break;
+		case EXRInteractionEvent::InteractionStarted:
+			if (Interaction)
+			{
+				Interaction->OnInteractionStarted.Broadcast(Interaction, Interactor);
+			}
+			break;
+		case EXRInteractionEvent::InteractionEnded:
+			if (Interaction)
+			{
+				Interaction->OnInteractionEnded.Broadcast(Interaction, Interactor);
+			}
+			break;
+	}
+}
@@ -1,16 +1,17 @@
 #include "Interactions/XRInteractionGrab.h"
 #include "Interactions/XRInteractorComponent.h"
+#include "Utilities/XRGrabFollowSubsystem.h"
 #include "Utilities/XRReplicatedPhysicsComponent.h"
 
 
 #include "Components/PrimitiveComponent.h"
 #include "PhysicsEngine/PhysicsConstraintComponent.h"
-#include "Net/UnrealNetwork.h"
 
 
 
 UXRInteractionGrab::UXRInteractionGrab()
 {
+	PrimaryComponentTick.bCanEverTick = true;
 	PrimaryComponentTick.bStartWithTickEnabled = false;
 	bAutoActivate = true;
 	SetIsReplicated(true);
@@ -21,10 +22,7 @@ UXRInteractionGrab::UXRInteractionGrab()
 void UXRInteractionGrab::BeginPlay()
 {
 	Super::BeginPlay();
-	if (bEnablePhysics)
-	{
-		InitializePhysics();
-	}
+	InitializePhysics();
 }
 
 
@@ -36,11 +34,20 @@ void UXRInteractionGrab::StartInteraction(UXRInteractorComponent* InInteractor)
 	Super::StartInteraction(InInteractor);
 	if (bEnablePhysics)
 	{
-		PhysicsGrab(InInteractor);
+		if (bEnableTwoHandedGrab && !bIsTwoHandedGrabActive && ActiveInteractors.Num() == 2)
+		{
+			StartTwoHandedGrab();
+		}
+		// Further XRInteractors don't influence a two-handed grab
+		else if (!bIsTwoHandedGrabActive)
+		{
+			PhysicsGrab(InInteractor);
+		}
 	}
 	else
 	{
 		AttachOwningActorToXRInteractor(InInteractor);
+		KinematicGrab();
 	}
 }
 
@@ -49,25 +56,33 @@ void UXRInteractionGrab::EndInteraction(UXRInteractorComponent* InInteractor)
 	Super::EndInteraction(InInteractor);
 	if (bEnablePhysics)
 	{
+		const bool bWasTwoHanded = bIsTwoHandedGrabActive;
+		if (bWasTwoHanded && (TwoHandedInteractors[0] == InInteractor || TwoHandedInteractors[1] == InInteractor))
+		{
+			StopTwoHandedGrab();
+		}
 		PhysicsUngrab(InInteractor);
-	}
-	else
-	{
-		DetachOwningActorFromXRInteractor();
-	}
 
-	// Update GrabActorsLocation for LateJoiners when Physics is disabled
-	if (!bEnablePhysics)
-	{
-		AActor* Owner = GetOwner();
-		if (Owner)
+		// The remaining XRInteractors continue holding
+		if (bWasTwoHanded && !bIsTwoHandedGrabActive)
 		{
-			if (Owner->HasAuthority())
+			TArray<UXRInteractorComponent*> RemainingInteractors = GetActiveInteractors();
+			if (RemainingInteractors.Num() >= 2)
+			{
+				StartTwoHandedGrab();
+			}
+			else if (RemainingInteractors.Num() == 1)
 			{
-				Server_UpdateGrabActorTransform();
+				PhysicsGrab(RemainingInteractors[0]);
 			}
 		}
 	}
+	else
+	{
+		// Rest snapshot is sent after detaching, so it carries the release transform
+		DetachOwningActorFromXRInteractor();
+		KinematicUngrab();
+	}
 }
 
 
@@ -77,6 +92,14 @@ void UXRInteractionGrab::EndInteraction(UXRInteractorComponent* InInteractor)
 
 void UXRInteractionGrab::AttachOwningActorToXRInteractor(UXRInteractorComponent* InInteractor)
 {
+	if (InInteractor && bFollowInsteadOfAttach)
+	{
+		if (UXRGrabFollowSubsystem* GrabFollow = GetWorld()->GetSubsystem<UXRGrabFollowSubsystem>())
+		{
+			GrabFollow->StartFollowing(GetOwner(), InInteractor);
+			return;
+		}
+	}
 	if (InInteractor)
 	{
 		FAttachmentTransformRules Rules(EAttachmentRule::KeepWorld, EAttachmentRule::KeepWorld, EAttachmentRule::KeepWorld, false);
@@ -86,10 +109,43 @@ void UXRInteractionGrab::AttachOwningActorToXRInteractor(UXRInteractorComponent*
 
 void UXRInteractionGrab::DetachOwningActorFromXRInteractor()
 {
+	UXRGrabFollowSubsystem* GrabFollow = GetWorld()->GetSubsystem<UXRGrabFollowSubsystem>();
+	if (GrabFollow && GrabFollow->IsFollowing(GetOwner()))
+	{
+		GrabFollow->StopFollowing(GetOwner());
+		return;
+	}
 	FDetachmentTransformRules Rules(EDetachmentRule::KeepWorld, EDetachmentRule::KeepWorld, EDetachmentRule::KeepWorld, false);
 	GetOwner()->DetachFromActor(Rules);
 }
 
+// Every machine moves the actor with its local XRInteractor, late joiners and released actors use the snapshots of the server
+void UXRInteractionGrab::KinematicGrab()
+{
+	if (!XRReplicatedPhysicsComponent)
+	{
+		return;
+	}
+	XRReplicatedPhysicsComponent->SetDrivenLocally(true);
+	if (GetOwner()->HasAuthority())
+	{
+		XRReplicatedPhysicsComponent->SetInteractedWith(true);
+	}
+}
+
+void UXRInteractionGrab::KinematicUngrab()
+{
+	if (!XRReplicatedPhysicsComponent || IsInteractedWith())
+	{
+		return;
+	}
+	XRReplicatedPhysicsComponent->SetDrivenLocally(false);
+	if (GetOwner()->HasAuthority())
+	{
+		XRReplicatedPhysicsComponent->SetInteractedWith(false);
+	}
+}
+
 // ------------------------------------------------------------------------------------------------------------------------------------------------------------
 // Physics
 // ------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -115,6 +171,16 @@ void UXRInteractionGrab::PhysicsGrab(UXRInteractorComponent* InInteractor)
 	if (MeshComponents.Num() > 0)
 	{
 		UMeshComponent* PhysicsEnabledMesh = MeshComponents[0];
+		if (bUsePooledConstraints)
+		{
+			UXRConstraintPoolSubsystem* ConstraintPool = GetWorld()->GetSubsystem<UXRConstraintPoolSubsystem>();
+			if (ConstraintPool && PhysicsEnabledMesh)
+			{
+				PooledConstraints.Add(InInteractor, ConstraintPool->AcquireConstraint(InInteractor, PhysicsEnabledMesh));
+			}
+			return;
+		}
+
 		UPhysicsConstraintComponent* ActivePhysicsConstraint = InInteractor->GetPhysicsConstraint();
 
 		if (ActivePhysicsConstraint && PhysicsEnabledMesh)
@@ -132,7 +198,24 @@ void UXRInteractionGrab::PhysicsGrab(UXRInteractorComponent* InInteractor)
 
 void UXRInteractionGrab::PhysicsUngrab(UXRInteractorComponent* InInteractor)
 {
-	if (InInteractor)
+	ReleaseGrabJoint(InInteractor);
+	if (GetOwner()->HasAuthority() && !IsInteractedWith())
+	{
+		XRReplicatedPhysicsComponent->SetInteractedWith(false);
+	}
+}
+
+void UXRInteractionGrab::ReleaseGrabJoint(UXRInteractorComponent* InInteractor)
+{
+	FXRConstraintHandle PooledConstraint;
+	if (PooledConstraints.RemoveAndCopyValue(InInteractor, PooledConstraint))
+	{
+		if (UXRConstraintPoolSubsystem* ConstraintPool = GetWorld()->GetSubsystem<UXRConstraintPoolSubsystem>())
+		{
+			ConstraintPool->ReleaseConstraint(PooledConstraint);
+		}
+	}
+	else if (InInteractor)
 	{
 		UPhysicsConstraintComponent* ActivePhysicsConstraint = InInteractor->GetPhysicsConstraint();
 		if (ActivePhysicsConstraint)
@@ -140,10 +223,105 @@ void UXRInteractionGrab::PhysicsUngrab(UXRInteractorComponent* InInteractor)
 			ActivePhysicsConstraint->BreakConstraint();
 		}
 	}
-	if (GetOwner()->HasAuthority() && !IsInteractedWith())
+}
+
+UPrimitiveComponent* UXRInteractionGrab::GetPhysicsGrabMesh() const
+{
+	if (!XRReplicatedPhysicsComponent)
 	{
-		XRReplicatedPhysicsComponent->SetInteractedWith(false);
+		return nullptr;
+	}
+	TArray<UMeshComponent*> MeshComponents = XRReplicatedPhysicsComponent->GetRegisteredMeshComponents();
+	return MeshComponents.Num() > 0 ? MeshComponents[0] : nullptr;
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Two-handed grab
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool UXRInteractionGrab::IsTwoHandedGrabActive() const
+{
+	return bIsTwoHandedGrabActive;
+}
+
+void UXRInteractionGrab::StartTwoHandedGrab()
+{
+	TArray<UXRInteractorComponent*> Interactors = GetActiveInteractors();
+	UPrimitiveComponent* Mesh = GetPhysicsGrabMesh();
+	if (Interactors.Num() < 2 || !Mesh)
+	{
+		return;
 	}
+
+	// Per-hand joints would fight the two-handed drive
+	ReleaseGrabJoint(Interactors[0]);
+	ReleaseGrabJoint(Interactors[1]);
+
+	TwoHandedInteractors[0] = Interactors[0];
+	TwoHandedInteractors[1] = Interactors[1];
+	TwoHandedMeshOffset = Mesh->GetComponentTransform().GetRelativeTransform(GetTwoHandedGripFrame(Interactors[0], Interactors[1]));
+	bIsTwoHandedGrabActive = true;
+
+	// Only the server simulates, clients follow the physics snapshots
+	if (GetOwner()->HasAuthority())
+	{
+		SetComponentTickEnabled(true);
+	}
+}
+
+void UXRInteractionGrab::StopTwoHandedGrab()
+{
+	bIsTwoHandedGrabActive = false;
+	TwoHandedInteractors[0] = nullptr;
+	TwoHandedInteractors[1] = nullptr;
+	SetComponentTickEnabled(false);
+}
+
+// Centered between both XRInteractors, X along the line between them, rolled by their average up vector
+FTransform UXRInteractionGrab::GetTwoHandedGripFrame(const USceneComponent* InFirst, const USceneComponent* InSecond)
+{
+	const FVector FirstLocation = InFirst->GetComponentLocation();
+	const FVector SecondLocation = InSecond->GetComponentLocation();
+
+	FVector GripAxis = (SecondLocation - FirstLocation).GetSafeNormal();
+	if (GripAxis.IsNearlyZero())
+	{
+		GripAxis = InFirst->GetForwardVector();
+	}
+	FVector GripUp = (InFirst->GetUpVector() + InSecond->GetUpVector()).GetSafeNormal();
+	if (GripUp.IsNearlyZero())
+	{
+		GripUp = FVector::UpVector;
+	}
+
+	return FTransform(FRotationMatrix::MakeFromXZ(GripAxis, GripUp).ToQuat(), (FirstLocation + SecondLocation) * 0.5f);
+}
+
+void UXRInteractionGrab::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	UXRInteractorComponent* FirstInteractor = TwoHandedInteractors[0].Get();
+	UXRInteractorComponent* SecondInteractor = TwoHandedInteractors[1].Get();
+	UPrimitiveComponent* Mesh = GetPhysicsGrabMesh();
+	if (!bIsTwoHandedGrabActive || !FirstInteractor || !SecondInteractor || !Mesh || DeltaTime <= 0.0f)
+	{
+		return;
+	}
+
+	const FTransform TargetTransform = TwoHandedMeshOffset * GetTwoHandedGripFrame(FirstInteractor, SecondInteractor);
+	const FTransform CurrentTransform = Mesh->GetComponentTransform();
+
+	// Velocity that closes TwoHandedFollowRate * DeltaTime of the error this step, at most all of it
+	const float VelocityScale = FMath::Min(TwoHandedFollowRate * DeltaTime, 1.0f) / DeltaTime;
+
+	FQuat DeltaRotation = TargetTransform.GetRotation() * CurrentTransform.GetRotation().Inverse();
+	DeltaRotation.EnforceShortestArcWith(FQuat::Identity);
+	FVector RotationAxis;
+	float RotationAngle;
+	DeltaRotation.ToAxisAndAngle(RotationAxis, RotationAngle);
+
+	Mesh->SetPhysicsLinearVelocity((TargetTransform.GetLocation() - CurrentTransform.GetLocation()) * VelocityScale);
+	Mesh->SetPhysicsAngularVelocityInRadians(RotationAxis * RotationAngle * VelocityScale);
 }
 
 void UXRInteractionGrab::InitializePhysics()
@@ -155,6 +333,12 @@ void UXRInteractionGrab::InitializePhysics()
 		if (FoundXRPhysicsComponent)
 		{
 			XRReplicatedPhysicsComponent = FoundXRPhysicsComponent;
+			XRReplicatedPhysicsComponent->bSimulatePhysics = bEnablePhysics;
+			// Its BeginPlay may already have started the simulation
+			if (!bEnablePhysics && XRReplicatedPhysicsComponent->HasBegunPlay() && GetOwnerRole() == ROLE_Authority)
+			{
+				XRReplicatedPhysicsComponent->SetSimulatePhysicsOnOwner(false);
+			}
 			return;
 		}
 		else
@@ -162,6 +346,7 @@ void UXRInteractionGrab::InitializePhysics()
 			XRReplicatedPhysicsComponent = NewObject<UXRReplicatedPhysicsComponent>(this->GetOwner());
 			if (XRReplicatedPhysicsComponent)
 			{
+				XRReplicatedPhysicsComponent->bSimulatePhysics = bEnablePhysics;
 				XRReplicatedPhysicsComponent->RegisterComponent();
 				XRReplicatedPhysicsComponent->Activate();
 				XRReplicatedPhysicsComponent->RegisterPhysicsMeshComponents(PhysicsTag);
@@ -175,34 +360,3 @@ UXRReplicatedPhysicsComponent* UXRInteractionGrab::GetPhysicsReplicationComponen
 	return XRReplicatedPhysicsComponent;
 }
 
-
-
-// ------------------------------------------------------------------------------------------------------------------------------------------------------------
-// Replication
-// ------------------------------------------------------------------------------------------------------------------------------------------------------------
-void UXRInteractionGrab::OnRep_GrabActorTransform()
-{
-	if (!bEnablePhysics)
-	{
-		AActor* Owner = GetOwner();
-		if (Owner)
-		{
-			Owner->SetActorTransform(GrabActorTransform);
-		}
-	}
-}
-
-void UXRInteractionGrab::Server_UpdateGrabActorTransform_Implementation()
-{
-	AActor* Owner = GetOwner();
-	if (Owner)
-	{
-		GrabActorTransform = Owner->GetActorTransform();
-	}
-}
-
-void UXRInteractionGrab::GetLifetimeReplicatedProps(TArray< FLifetimeProperty >& OutLifetimeProps) const
-{
-	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
-	DOREPLIFETIME(UXRInteractionGrab, GrabActorTransform);
-}
\ No newline at end of file
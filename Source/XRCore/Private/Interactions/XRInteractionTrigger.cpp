@@ -1,9 +1,11 @@
 #include "Interactions/XRInteractionTrigger.h"
 #include "Interactions/XRInteractorComponent.h"
+#include "Interactions/XRTriggerSchedulerSubsystem.h"
+#include "Utilities/XRCoreNetStats.h"
 
-#include "TimerManager.h"
 #include "Net/UnrealNetwork.h"
 #include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
 
 
 
@@ -16,9 +18,9 @@ UXRInteractionTrigger::UXRInteractionTrigger()
 void UXRInteractionTrigger::BeginPlay()
 {
 	Super::BeginPlay();
-	if (GetTriggerState() != DefaultTriggerState)
+	if (GetOwnerRole() == ROLE_Authority && GetTriggerState() != DefaultTriggerState)
 	{
-		Server_SetTriggerState(DefaultTriggerState, nullptr);
+		ApplyTriggerState(DefaultTriggerState, EXRInteractionTriggerPhase::Idle, nullptr);
 	}
 }
 
@@ -27,26 +29,31 @@ void UXRInteractionTrigger::BeginPlay()
 // ------------------------------------------------------------------------------------------------------------------------------------------------------------
 void UXRInteractionTrigger::StartInteraction(UXRInteractorComponent* InInteractor)
 {
-	// Only Interact for the first Interactor (if multiple)
-	if (GetActiveInteractors().Num() > 0)
+	// Only Interact for the first Interactor (if multiple), clients follow the replicated state
+	if (NumActiveInteractors() > 0 || GetOwnerRole() != ROLE_Authority)
 	{
 		Super::StartInteraction(InInteractor);
 		return;
 	}
 
 	Super::StartInteraction(InInteractor);
+	// Presses during a cooldown are ignored, the scheduled end terminates them
+	if (TriggerState.Phase == EXRInteractionTriggerPhase::Cooldown)
+	{
+		return;
+	}
+
+	const EXRInteractionTriggerPhase PressPhase = TriggerBehavior != EXRInteractionTriggerBehavior::Hold && InteractionDuration > 0.0f
+		? EXRInteractionTriggerPhase::Cooldown
+		: EXRInteractionTriggerPhase::Held;
 	switch (TriggerBehavior)
 	{
 		case EXRInteractionTriggerBehavior::Trigger:
-			Server_SetTriggerState(!DefaultTriggerState, InInteractor);
-			EndInteractionAfterTimer();
+		case EXRInteractionTriggerBehavior::Hold:
+			ApplyTriggerState(!DefaultTriggerState, PressPhase, InInteractor);
 			break;
 		case EXRInteractionTriggerBehavior::Toggle:
-			Server_SetTriggerState(!GetTriggerState(), InInteractor);
-			EndInteractionAfterTimer();
-			break;
-		case EXRInteractionTriggerBehavior::Hold:
-			Server_SetTriggerState(!DefaultTriggerState, InInteractor);
+			ApplyTriggerState(!GetTriggerState(), PressPhase, InInteractor);
 			break;
 	}
 }
@@ -54,22 +61,25 @@ void UXRInteractionTrigger::StartInteraction(UXRInteractorComponent* InInteracto
 void UXRInteractionTrigger::EndInteraction(UXRInteractorComponent* InInteractor)
 {
 	// Only set TriggerState when last Interactor stops interacting 
-	if (GetActiveInteractors().Num() > 1)
+	if (NumActiveInteractors() > 1 || GetOwnerRole() != ROLE_Authority)
 	{
 		Super::EndInteraction(InInteractor);
 		return;
 	}
 
 	Super::EndInteraction(InInteractor);
+	// A cooldown runs to its scheduled end, even if released early
+	const EXRInteractionTriggerPhase ReleasePhase = TriggerState.Phase == EXRInteractionTriggerPhase::Cooldown
+		? EXRInteractionTriggerPhase::Cooldown
+		: EXRInteractionTriggerPhase::Idle;
 	switch (TriggerBehavior)
 	{
 		case EXRInteractionTriggerBehavior::Trigger:
-			Server_SetTriggerState(DefaultTriggerState, InInteractor);
+		case EXRInteractionTriggerBehavior::Hold:
+			ApplyTriggerState(DefaultTriggerState, ReleasePhase, InInteractor);
 			break;
 		case EXRInteractionTriggerBehavior::Toggle:
-			break;
-		case EXRInteractionTriggerBehavior::Hold:
-			Server_SetTriggerState(DefaultTriggerState, InInteractor);
+			ApplyTriggerState(GetTriggerState(), ReleasePhase, InInteractor);
 			break;
 	}
 }
@@ -79,10 +89,9 @@ void UXRInteractionTrigger::EndInteraction(UXRInteractorComponent* InInteractor)
 // ------------------------------------------------------------------------------------------------------------------------------------------------------------
 void UXRInteractionTrigger::SetTriggerState(bool InTriggerState, UXRInteractorComponent* InInteractor)
 {
-	if (GetWorld()->GetNetMode() == NM_Standalone)
+	if (GetOwnerRole() == ROLE_Authority)
 	{
-		bTriggerState = InTriggerState;
-		OnTriggerStateChanged.Broadcast(this, bTriggerState, InInteractor);
+		ApplyTriggerState(InTriggerState, TriggerState.Phase, InInteractor);
 		return;
 	}
 	Server_SetTriggerState(InTriggerState, InInteractor);
@@ -90,21 +99,63 @@ void UXRInteractionTrigger::SetTriggerState(bool InTriggerState, UXRInteractorCo
 
 void UXRInteractionTrigger::Server_SetTriggerState_Implementation(bool InTriggerState, UXRInteractorComponent* InInteractor)
 {
-	if (InTriggerState == bTriggerState)
+	ApplyTriggerState(InTriggerState, TriggerState.Phase, InInteractor);
+}
+
+void UXRInteractionTrigger::ApplyTriggerState(bool InTriggerState, EXRInteractionTriggerPhase InPhase, UXRInteractorComponent* InInteractor)
+{
+	const bool bStateChanged = InTriggerState != TriggerState.bTriggerState;
+	const bool bPhaseChanged = InPhase != TriggerState.Phase;
+	if (!bStateChanged && !bPhaseChanged)
 	{
 		return;
 	}
-	bTriggerState = InTriggerState;
-	OnTriggerStateChanged.Broadcast(this, bTriggerState, InInteractor);
-	if (GetWorld()->GetNetMode() == NM_Standalone)
+
+	TriggerState.bTriggerState = InTriggerState;
+	TriggerState.Phase = InPhase;
+	if (bPhaseChanged)
+	{
+		TriggerState.ChangeTime = GetWorld()->GetTimeSeconds();
+	}
+	XRCORE_RECORD_NET_MESSAGE(EXRNetFeature::TriggerState, FXRCoreNetStats::GetNetSerializedBytes(TriggerState), FXRCoreNetStats::GetNumClientReceivers(GetOwner()));
+	FlushOwnerNetDormancy();
+
+	if (bPhaseChanged && InPhase == EXRInteractionTriggerPhase::Cooldown)
+	{
+		if (UXRTriggerSchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UXRTriggerSchedulerSubsystem>())
+		{
+			Scheduler->ScheduleCooldownEnd(this, TriggerState.ChangeTime + InteractionDuration);
+		}
+	}
+
+	// Listen server and standalone only broadcast here, OnRep_TriggerState covers clients
+	if (bStateChanged)
 	{
-		OnTriggerStateChanged.Broadcast(this, bTriggerState, InInteractor);
+		OnTriggerStateChanged.Broadcast(this, TriggerState.bTriggerState, InInteractor);
 	}
 }
 
 bool UXRInteractionTrigger::GetTriggerState() const
 {
-	return bTriggerState;
+	return TriggerState.bTriggerState;
+}
+
+EXRInteractionTriggerPhase UXRInteractionTrigger::GetTriggerPhase() const
+{
+	return TriggerState.Phase;
+}
+
+float UXRInteractionTrigger::GetCooldownProgress() const
+{
+	if (TriggerState.Phase != EXRInteractionTriggerPhase::Cooldown || InteractionDuration <= 0.0f)
+	{
+		return 1.0f;
+	}
+	// Clients compare against the server clock of the GameState, no extra traffic
+	const UWorld* World = GetWorld();
+	const AGameStateBase* GameState = World->GetGameState();
+	const double ServerTime = GameState ? GameState->GetServerWorldTimeSeconds() : World->GetTimeSeconds();
+	return FMath::Clamp(static_cast<float>(ServerTime - TriggerState.ChangeTime) / InteractionDuration, 0.0f, 1.0f);
 }
 
 void UXRInteractionTrigger::SetTriggerBehavior(EXRInteractionTriggerBehavior InTriggerBehavior)
@@ -116,46 +167,47 @@ EXRInteractionTriggerBehavior UXRInteractionTrigger::GetTriggerBehavior() const
 {
 	return TriggerBehavior;
 }
-// Disable the component until the started timer completes.
-void UXRInteractionTrigger::EndInteractionAfterTimer()
+
+// End the interaction of a timed press once its cooldown has passed.
+void UXRInteractionTrigger::OnCooldownElapsed(double InScheduledTime)
 {
-	if (GetOwnerRole() != ROLE_Authority)
+	// Stale entry of an earlier cooldown
+	if (TriggerState.Phase != EXRInteractionTriggerPhase::Cooldown || !FMath::IsNearlyEqual(TriggerState.ChangeTime + InteractionDuration, InScheduledTime, KINDA_SMALL_NUMBER))
 	{
 		return;
 	}
-	if (InteractionDuration > 0.0f)
-	{
-		FTimerManager& TimerManager = GetWorld()->GetTimerManager();
-		TimerManager.SetTimer(CooldownTimerHandle, this, &UXRInteractionTrigger::RequestInteractionTermination, InteractionDuration, false);
-	}
+
+	RequestInteractionTermination();
+	const bool bEndState = TriggerBehavior == EXRInteractionTriggerBehavior::Toggle ? GetTriggerState() : DefaultTriggerState;
+	ApplyTriggerState(bEndState, EXRInteractionTriggerPhase::Idle, nullptr);
 }
 
 void UXRInteractionTrigger::RequestInteractionTermination()
 {
-	if (GetActiveInteractors().Num() > 0)
+	// Stopping removes the interactor from the active set
+	FXRInteractorArray Interactors;
+	CopyActiveInteractors(Interactors);
+	for (UXRInteractorComponent* Interactor : Interactors)
 	{
-		for (auto Interactor : GetActiveInteractors())
-		{
-			Interactor->StopXRInteraction(this);
-		}
+		Interactor->StopXRInteraction(this);
 	}
 }
 
 // ------------------------------------------------------------------------------------------------------------------------------------------------------------
 // Replication
 // ------------------------------------------------------------------------------------------------------------------------------------------------------------
-void UXRInteractionTrigger::OnRep_TriggerState()
+void UXRInteractionTrigger::OnRep_TriggerState(const FXRInteractionTriggerState& PreviousTriggerState)
 {
-	if (GetActiveInteractors().Num() > 0)
+	// Phase changes only update the cooldown
+	if (PreviousTriggerState.bTriggerState == TriggerState.bTriggerState)
 	{
-		OnTriggerStateChanged.Broadcast(this, bTriggerState, GetActiveInteractors()[0]);
 		return;
 	}
-	OnTriggerStateChanged.Broadcast(this, bTriggerState, nullptr);
+	OnTriggerStateChanged.Broadcast(this, TriggerState.bTriggerState, GetFirstActiveInteractor());
 }
 
 void UXRInteractionTrigger::GetLifetimeReplicatedProps(TArray< FLifetimeProperty >& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
-	DOREPLIFETIME(UXRInteractionTrigger, bTriggerState);
+	DOREPLIFETIME(UXRInteractionTrigger, TriggerState);
 }
@@ -1,15 +1,29 @@
 #include "Interactions/XRInteractorComponent.h"
+#include "Core/XRCoreStats.h"
 #include "Interactions/XRInteractionComponent.h"
+#include "Interactions/XRInteractionEventSubsystem.h"
+#include "Interactions/XRInteractorSubsystem.h"
+#include "Utilities/XRCoreNetStats.h"
 #include "Utilities/XRToolsUtilityFunctions.h"
 
+#include "Engine/OverlapResult.h"
+#include "Engine/World.h"
 #include "GameFramework/Pawn.h"
 #include "Net/UnrealNetwork.h"
 
+namespace XRInteractorProximity
+{
+	// Shared by all interactors, queries run on the game thread one after another
+	TArray<FOverlapResult> QueryResults;
+}
+
 UXRInteractorComponent::UXRInteractorComponent()
 {
 	SphereRadius = 0.8f;
-	PrimaryComponentTick.bCanEverTick = false;
+	// Only ticks in the Query proximity mode, after hands and grabbed props have moved
+	PrimaryComponentTick.bCanEverTick = true;
 	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PostPhysics;
 	SetIsReplicatedByDefault(true);
 	bAutoActivate = true;
 }
@@ -22,13 +36,38 @@ void UXRInteractorComponent::InitializeComponent()
 void UXRInteractorComponent::BeginPlay()
 {
 	Super::BeginPlay();
+	if (UXRInteractorSubsystem* InteractorSubsystem = GetWorld()->GetSubsystem<UXRInteractorSubsystem>())
+	{
+		InteractorSubsystem->RegisterInteractor(this);
+	}
+	if (ProximityMode == EXRInteractorProximityMode::Query)
+	{
+		SetGenerateOverlapEvents(false);
+		SetComponentTickEnabled(true);
+		return;
+	}
 	OnComponentBeginOverlap.AddDynamic(this, &UXRInteractorComponent::OnOverlapBegin);
 	OnComponentEndOverlap.AddDynamic(this, &UXRInteractorComponent::OnOverlapEnd);
 }
 
-void UXRInteractorComponent::EndPlay(const EEndPlayReason::Type)
+void UXRInteractorComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+	if (ProximityMode == EXRInteractorProximityMode::Query)
+	{
+		UpdateProximityQuery();
+	}
+}
+
+void UXRInteractorComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 	SetAdditionalColliders({});
+	UWorld* World = GetWorld();
+	if (UXRInteractorSubsystem* InteractorSubsystem = World ? World->GetSubsystem<UXRInteractorSubsystem>() : nullptr)
+	{
+		InteractorSubsystem->UnregisterInteractor(this);
+	}
+	Super::EndPlay(EndPlayReason);
 }
 
 // ------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -85,6 +124,8 @@ void UXRInteractorComponent::Server_ExecuteInteraction_Implementation(UXRInterac
 		return;
 	}
 	Multicast_ExecuteInteraction(InInteractionComponent);
+	// The component reference goes out as a net GUID, its packed size is not known here
+	XRCORE_RECORD_NET_MESSAGE_ESTIMATE(EXRNetFeature::InteractionMulticast, sizeof(uint32), FXRCoreNetStats::GetNumClientReceivers(GetOwner()));
 }
 
 void UXRInteractorComponent::Multicast_ExecuteInteraction_Implementation(UXRInteractionComponent* InteractionComponent)
@@ -93,10 +134,10 @@ void UXRInteractorComponent::Multicast_ExecuteInteraction_Implementation(UXRInte
 	{
 		return;
 	}
-	ActiveInteractionComponents.AddUnique(InteractionComponent);
+	ActiveInteractionComponents.Add(TWeakObjectPtr<UXRInteractionComponent>(InteractionComponent));
 	InteractionComponent->StartInteraction(this);
-	OnStartedInteracting.Broadcast(this, InteractionComponent);
-	HoveredInteractionComponents.Remove(InteractionComponent);
+	UXRInteractionEventSubsystem::Post(this, EXRInteractionEvent::InteractorStarted, this, InteractionComponent);
+	HoveredInteractionComponents.Remove(TWeakObjectPtr<UXRInteractionComponent>(InteractionComponent));
 }
 
 
@@ -140,6 +181,8 @@ void UXRInteractorComponent::Server_TerminateInteraction_Implementation(UXRInter
 		return;
 	}
 	Multicast_TerminateInteraction(InInteractionComponent);
+	// The component reference goes out as a net GUID, its packed size is not known here
+	XRCORE_RECORD_NET_MESSAGE_ESTIMATE(EXRNetFeature::InteractionMulticast, sizeof(uint32), FXRCoreNetStats::GetNumClientReceivers(GetOwner()));
 }
 
 void UXRInteractorComponent::Multicast_TerminateInteraction_Implementation(UXRInteractionComponent* InteractionComponent)
@@ -149,8 +192,8 @@ void UXRInteractorComponent::Multicast_TerminateInteraction_Implementation(UXRIn
 		return;
 	}
 	InteractionComponent->EndInteraction(this);
-	ActiveInteractionComponents.Remove(InteractionComponent);
-	OnStoppedInteracting.Broadcast(this, InteractionComponent);
+	ActiveInteractionComponents.Remove(TWeakObjectPtr<UXRInteractionComponent>(InteractionComponent));
+	UXRInteractionEventSubsystem::Post(this, EXRInteractionEvent::InteractorStopped, this, InteractionComponent);
 
 	// Restart Highlight after Interaction End (if hovering)
 	if (GetOverlappedXRInteractions().Contains(InteractionComponent))
@@ -171,19 +214,11 @@ bool UXRInteractorComponent::CanInteract(UXRInteractionComponent*& OutPrioritize
 
 TArray<UXRInteractionComponent*> UXRInteractorComponent::GetOverlappedXRInteractions() const
 {
+	XRCORE_SCOPE_CYCLE_COUNTER(STAT_XRCore_InteractorOverlaps);
 	TArray<UXRInteractionComponent*> FoundXRInteractions = {};
 
 	TArray<UPrimitiveComponent*> OverlappingComps = {};
-	GetOverlappingComponents(OverlappingComps);
-	for (auto Collider : AdditionalColliders)
-	{
-		TArray<UPrimitiveComponent*> AdditionalOverlappingComps = {};
-		Collider->GetOverlappingComponents(AdditionalOverlappingComps);
-		for (auto AdditionalOverlappingComp : AdditionalOverlappingComps)
-		{
-			OverlappingComps.AddUnique(AdditionalOverlappingComp);
-		}
-	}
+	GetProximityComponents(OverlappingComps);
 
 	for (UPrimitiveComponent* OverlappingComponent : OverlappingComps)
 	{
@@ -205,6 +240,18 @@ TArray<UXRInteractionComponent*> UXRInteractorComponent::GetOverlappedXRInteract
 TArray<AActor*> UXRInteractorComponent::GetAllOverlappingActors() const
 {
 	TArray<AActor*> OverlappingActors = {};
+	if (ProximityMode == EXRInteractorProximityMode::Query)
+	{
+		for (const TWeakObjectPtr<UPrimitiveComponent>& ProximityComponent : ProximityComponents)
+		{
+			if (ProximityComponent.IsValid() && ProximityComponent->GetOwner())
+			{
+				OverlappingActors.AddUnique(ProximityComponent->GetOwner());
+			}
+		}
+		return OverlappingActors;
+	}
+
 	TArray<AActor*> TempActors = {};
 	GetOverlappingActors(OverlappingActors);
 
@@ -227,20 +274,30 @@ TArray<AActor*> UXRInteractorComponent::GetAllOverlappingActors() const
 }
 
 
-TArray<UXRInteractionComponent*> UXRInteractorComponent::GetChildXRInteractionComponents(UPrimitiveComponent* InComponent)
+void UXRInteractorComponent::GetProximityComponents(TArray<UPrimitiveComponent*>& OutComponents) const
 {
-	TArray<UXRInteractionComponent*> FoundXRInteractions = {};
-	TArray<USceneComponent*> ChildComponents;
-	InComponent->GetChildrenComponents(true, ChildComponents);
-	for (USceneComponent* ChildComponent : ChildComponents)
+	if (ProximityMode == EXRInteractorProximityMode::Query)
 	{
-		UXRInteractionComponent* FoundXRInteraction = Cast<UXRInteractionComponent>(ChildComponent);
-		if (FoundXRInteraction)
+		for (const TWeakObjectPtr<UPrimitiveComponent>& ProximityComponent : ProximityComponents)
 		{
-			FoundXRInteractions.Add(FoundXRInteraction);
+			if (ProximityComponent.IsValid())
+			{
+				OutComponents.Add(ProximityComponent.Get());
+			}
+		}
+		return;
+	}
+
+	GetOverlappingComponents(OutComponents);
+	for (auto Collider : AdditionalColliders)
+	{
+		TArray<UPrimitiveComponent*> AdditionalOverlappingComps = {};
+		Collider->GetOverlappingComponents(AdditionalOverlappingComps);
+		for (auto AdditionalOverlappingComp : AdditionalOverlappingComps)
+		{
+			OutComponents.AddUnique(AdditionalOverlappingComp);
 		}
 	}
-	return FoundXRInteractions;
 }
 
 // ------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -262,7 +319,11 @@ void UXRInteractorComponent::SetAdditionalColliders(TArray<UPrimitiveComponent*>
 	AdditionalColliders = InColliders;
 	for (UPrimitiveComponent* Collider : AdditionalColliders)
 	{
-		if (Collider)
+		if (Collider && ProximityMode == EXRInteractorProximityMode::Query)
+		{
+			Collider->SetGenerateOverlapEvents(false);
+		}
+		else if (Collider)
 		{
 			Collider->OnComponentBeginOverlap.AddDynamic(this, &UXRInteractorComponent::OnOverlapBegin);
 			Collider->OnComponentEndOverlap.AddDynamic(this, &UXRInteractorComponent::OnOverlapEnd);
@@ -292,9 +353,10 @@ bool UXRInteractorComponent::IsAnyColliderOverlappingComponent(UPrimitiveCompone
 void UXRInteractorComponent::OnOverlapBegin(UPrimitiveComponent* OverlappedComp, AActor* OtherActor,
 	UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
 {
+	XRCORE_SCOPE_CYCLE_COUNTER(STAT_XRCore_InteractorOverlaps);
 	if (!IsAnyColliderOverlappingComponent(OtherComp, true))
 	{
-		UXRInteractionComponent* PrioritizedInteraction = UXRToolsUtilityFunctions::GetXRInteractionByPriority(GetChildXRInteractionComponents(OtherComp), this, 0, EXRInteractionPrioritySelection::LowerEqual);
+		UXRInteractionComponent* PrioritizedInteraction = UXRToolsUtilityFunctions::GetXRInteractionByPriority(UXRToolsUtilityFunctions::GetChildXRInteractions(OtherComp), this, 0, EXRInteractionPrioritySelection::LowerEqual);
 		if (PrioritizedInteraction)
 		{
 			RequestHover(PrioritizedInteraction, true);
@@ -305,15 +367,71 @@ void UXRInteractorComponent::OnOverlapBegin(UPrimitiveComponent* OverlappedComp,
 void UXRInteractorComponent::OnOverlapEnd(UPrimitiveComponent* OverlappedComp, AActor* OtherActor,
 	UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
 {
+	XRCORE_SCOPE_CYCLE_COUNTER(STAT_XRCore_InteractorOverlaps);
 	if (!IsAnyColliderOverlappingComponent(OtherComp, true))
 	{
-		for (auto Interaction : GetChildXRInteractionComponents(OtherComp))
+		for (auto Interaction : UXRToolsUtilityFunctions::GetChildXRInteractions(OtherComp))
 		{
 			RequestHover(Interaction, false);
 		}
 	}
 }
 
+// Same hover rules as OnOverlapBegin / OnOverlapEnd, applied to the difference between the last and the current query
+void UXRInteractorComponent::UpdateProximityQuery()
+{
+	XRCORE_SCOPE_CYCLE_COUNTER(STAT_XRCore_InteractorOverlaps);
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	FProximityComponentSet CurrentComponents;
+	FComponentQueryParams QueryParams(SCENE_QUERY_STAT(XRInteractorProximity), GetOwner());
+	TArray<UPrimitiveComponent*, TInlineAllocator<4>> Colliders = { this };
+	Colliders.Append(AdditionalColliders);
+	for (UPrimitiveComponent* Collider : Colliders)
+	{
+		if (!Collider || !Collider->IsCollisionEnabled())
+		{
+			continue;
+		}
+		XRInteractorProximity::QueryResults.Reset();
+		World->ComponentOverlapMulti(XRInteractorProximity::QueryResults, Collider, Collider->GetComponentLocation(), Collider->GetComponentQuat(), QueryParams);
+		for (const FOverlapResult& Overlap : XRInteractorProximity::QueryResults)
+		{
+			if (UPrimitiveComponent* OverlapComponent = Overlap.GetComponent())
+			{
+				CurrentComponents.Add(OverlapComponent);
+			}
+		}
+	}
+
+	for (const TWeakObjectPtr<UPrimitiveComponent>& PreviousComponent : ProximityComponents)
+	{
+		if (PreviousComponent.IsValid() && !CurrentComponents.Contains(PreviousComponent))
+		{
+			for (auto Interaction : UXRToolsUtilityFunctions::GetChildXRInteractions(PreviousComponent.Get()))
+			{
+				RequestHover(Interaction, false);
+			}
+		}
+	}
+	for (const TWeakObjectPtr<UPrimitiveComponent>& CurrentComponent : CurrentComponents)
+	{
+		if (!ProximityComponents.Contains(CurrentComponent))
+		{
+			UXRInteractionComponent* PrioritizedInteraction = UXRToolsUtilityFunctions::GetXRInteractionByPriority(UXRToolsUtilityFunctions::GetChildXRInteractions(CurrentComponent.Get()), this, 0, EXRInteractionPrioritySelection::LowerEqual);
+			if (PrioritizedInteraction)
+			{
+				RequestHover(PrioritizedInteraction, true);
+			}
+		}
+	}
+	ProximityComponents = MoveTemp(CurrentComponents);
+}
+
 // ------------------------------------------------------------------------------------------------------------------------------------------------------------
 // Hovering
 // ------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -325,20 +443,20 @@ void UXRInteractorComponent::RequestHover(UXRInteractionComponent* InInteraction
 	}
 	if (bInHoverState)
 	{
-		if (!HoveredInteractionComponents.Contains(InInteraction))
+		bool bAlreadyHovered = false;
+		HoveredInteractionComponents.Add(TWeakObjectPtr<UXRInteractionComponent>(InInteraction), &bAlreadyHovered);
+		if (!bAlreadyHovered)
 		{
-			HoveredInteractionComponents.Add(InInteraction);
 			InInteraction->HoverInteraction(this, true);
-			OnHoverStateChanged.Broadcast(this, InInteraction, true);
+			UXRInteractionEventSubsystem::Post(this, EXRInteractionEvent::InteractorHover, this, InInteraction, true);
 		}
 	}
 	if (!bInHoverState)
 	{
-		if (HoveredInteractionComponents.Contains(InInteraction))
+		if (HoveredInteractionComponents.Remove(TWeakObjectPtr<UXRInteractionComponent>(InInteraction)) > 0)
 		{
-			HoveredInteractionComponents.Remove(InInteraction);
 			InInteraction->HoverInteraction(this, false);
-			OnHoverStateChanged.Broadcast(this, InInteraction, false);
+			UXRInteractionEventSubsystem::Post(this, EXRInteractionEvent::InteractorHover, this, InInteraction, false);
 		}
 	}
 }
@@ -349,7 +467,17 @@ void UXRInteractorComponent::RequestHover(UXRInteractionComponent* InInteraction
 // ------------------------------------------------------------------------------------------------------------------------------------------------------------
 bool UXRInteractorComponent::IsInteracting() const
 {
-	return !ActiveInteractionComponents.IsEmpty();
+	return ActiveInteractionComponents.Num() > 0;
+}
+
+bool UXRInteractorComponent::IsInteractingWith(const UXRInteractionComponent* InInteraction) const
+{
+	return InInteraction && ActiveInteractionComponents.Contains(TWeakObjectPtr<UXRInteractionComponent>(const_cast<UXRInteractionComponent*>(InInteraction)));
+}
+
+bool UXRInteractorComponent::IsHovering(const UXRInteractionComponent* InInteraction) const
+{
+	return InInteraction && HoveredInteractionComponents.Contains(TWeakObjectPtr<UXRInteractionComponent>(const_cast<UXRInteractionComponent*>(InInteraction)));
 }
 
 void UXRInteractorComponent::Server_SetXRControllerHand_Implementation(EControllerHand InXRControllerHand)
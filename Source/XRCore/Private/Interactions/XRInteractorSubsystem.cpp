@@ -0,0 +1,20 @@
+#include "Interactions/XRInteractorSubsystem.h"
+#include "Interactions/XRInteractorComponent.h"
+
+bool UXRInteractorSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UXRInteractorSubsystem::RegisterInteractor(UXRInteractorComponent* InInteractor)
+{
+	if (InInteractor)
+	{
+		Interactors.AddUnique(InInteractor);
+	}
+}
+
+void UXRInteractorSubsystem::UnregisterInteractor(UXRInteractorComponent* InInteractor)
+{
+	Interactors.RemoveSwap(InInteractor);
+}
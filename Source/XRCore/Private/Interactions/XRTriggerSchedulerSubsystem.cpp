@@ -0,0 +1,53 @@
+#include "Interactions/XRTriggerSchedulerSubsystem.h"
+#include "Core/XRCoreStats.h"
+#include "Interactions/XRInteractionTrigger.h"
+
+#include "Engine/World.h"
+
+bool UXRTriggerSchedulerSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UXRTriggerSchedulerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UXRTriggerSchedulerSubsystem, STATGROUP_Tickables);
+}
+
+void UXRTriggerSchedulerSubsystem::ScheduleCooldownEnd(UXRInteractionTrigger* InTrigger, double InTime)
+{
+	if (!InTrigger)
+	{
+		return;
+	}
+	FXRScheduledTrigger ScheduledTrigger;
+	ScheduledTrigger.Time = InTime;
+	ScheduledTrigger.Trigger = InTrigger;
+	ScheduledTriggers.HeapPush(ScheduledTrigger);
+}
+
+int32 UXRTriggerSchedulerSubsystem::GetNumScheduled() const
+{
+	return ScheduledTriggers.Num();
+}
+
+void UXRTriggerSchedulerSubsystem::Tick(float DeltaTime)
+{
+	if (ScheduledTriggers.Num() == 0)
+	{
+		return;
+	}
+	XRCORE_SCOPE_CYCLE_COUNTER(STAT_XRCore_TriggerScheduler);
+
+	const double WorldTime = GetWorld()->GetTimeSeconds();
+	while (ScheduledTriggers.Num() > 0 && ScheduledTriggers.HeapTop().Time <= WorldTime)
+	{
+		FXRScheduledTrigger ScheduledTrigger;
+		ScheduledTriggers.HeapPop(ScheduledTrigger, false);
+		// May schedule again, the heap is consistent at this point
+		if (UXRInteractionTrigger* Trigger = ScheduledTrigger.Trigger.Get())
+		{
+			Trigger->OnCooldownElapsed(ScheduledTrigger.Time);
+		}
+	}
+}
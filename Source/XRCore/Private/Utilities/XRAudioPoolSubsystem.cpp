@@ -0,0 +1,198 @@
+#include "Utilities/XRAudioPoolSubsystem.h"
+#include "Core/XRCoreSettings.h"
+
+#include "Components/AudioComponent.h"
+#include "CoreGlobals.h"
+#include "Engine/World.h"
+#include "Misc/App.h"
+
+void UXRAudioPoolSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const UXRCoreSettings* Settings = GetDefault<UXRCoreSettings>();
+	MaxVoices = FMath::Max(Settings->AudioPoolSize, 1);
+	MaxPlaybacksPerFrame = FMath::Max(Settings->MaxInteractionSoundsPerFrame, 1);
+}
+
+void UXRAudioPoolSubsystem::Deinitialize()
+{
+	for (UAudioComponent* Voice : Voices)
+	{
+		if (IsValid(Voice))
+		{
+			Voice->Stop();
+			Voice->DestroyComponent();
+		}
+	}
+	Voices.Empty();
+	VoiceSerials.Empty();
+	VoiceStartTimes.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UXRAudioPoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Playback
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+FXRAudioVoiceHandle UXRAudioPoolSubsystem::PlaySoundAtLocation(USoundBase* InSound, const FVector& InLocation)
+{
+	if (!InSound || !CanPlayAudio())
+	{
+		return FXRAudioVoiceHandle();
+	}
+
+	// Cap the number of sounds started in a single frame, further requests in the same frame are dropped
+	if (CurrentPlaybackFrame != GFrameCounter)
+	{
+		CurrentPlaybackFrame = GFrameCounter;
+		PlaybacksThisFrame = 0;
+	}
+	if (PlaybacksThisFrame >= MaxPlaybacksPerFrame)
+	{
+		return FXRAudioVoiceHandle();
+	}
+
+	const int32 VoiceIndex = AcquireVoiceIndex();
+	if (VoiceIndex == INDEX_NONE)
+	{
+		return FXRAudioVoiceHandle();
+	}
+
+	UAudioComponent* Voice = Voices[VoiceIndex];
+	if (Voice->IsPlaying())
+	{
+		Voice->Stop();
+	}
+	Voice->SetSound(InSound);
+	Voice->SetWorldLocation(InLocation);
+	Voice->Play();
+
+	PlaybacksThisFrame++;
+	VoiceSerials[VoiceIndex] = NextSerial++;
+	VoiceStartTimes[VoiceIndex] = GetWorld()->GetTimeSeconds();
+
+	FXRAudioVoiceHandle OutHandle;
+	OutHandle.VoiceIndex = VoiceIndex;
+	OutHandle.Serial = VoiceSerials[VoiceIndex];
+	return OutHandle;
+}
+
+void UXRAudioPoolSubsystem::StopVoice(const FXRAudioVoiceHandle& InHandle)
+{
+	if (IsVoicePlaying(InHandle))
+	{
+		Voices[InHandle.VoiceIndex]->Stop();
+	}
+}
+
+bool UXRAudioPoolSubsystem::IsVoicePlaying(const FXRAudioVoiceHandle& InHandle) const
+{
+	return IsHandleCurrent(InHandle) && Voices[InHandle.VoiceIndex]->IsPlaying();
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Voices
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Prefer an idle voice, then grow the pool, then steal the voice that has been playing the longest
+int32 UXRAudioPoolSubsystem::AcquireVoiceIndex()
+{
+	for (int32 Index = 0; Index < Voices.Num(); Index++)
+	{
+		if (IsValid(Voices[Index]) && !Voices[Index]->IsPlaying())
+		{
+			return Index;
+		}
+	}
+
+	if (Voices.Num() < MaxVoices)
+	{
+		UAudioComponent* NewVoice = CreateVoice();
+		if (!NewVoice)
+		{
+			return INDEX_NONE;
+		}
+		VoiceSerials.Add(0);
+		VoiceStartTimes.Add(0.0);
+		return Voices.Add(NewVoice);
+	}
+
+	int32 OldestIndex = INDEX_NONE;
+	double OldestStartTime = TNumericLimits<double>::Max();
+	for (int32 Index = 0; Index < Voices.Num(); Index++)
+	{
+		if (IsValid(Voices[Index]) && VoiceStartTimes[Index] < OldestStartTime)
+		{
+			OldestStartTime = VoiceStartTimes[Index];
+			OldestIndex = Index;
+		}
+	}
+	return OldestIndex;
+}
+
+UAudioComponent* UXRAudioPoolSubsystem::CreateVoice()
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	UAudioComponent* NewVoice = NewObject<UAudioComponent>(World);
+	if (!NewVoice)
+	{
+		return nullptr;
+	}
+	NewVoice->bAutoActivate = false;
+	NewVoice->bAutoDestroy = false;
+	NewVoice->bStopWhenOwnerDestroyed = false;
+	NewVoice->bAllowSpatialization = true;
+	NewVoice->bIsUISound = false;
+	NewVoice->RegisterComponentWithWorld(World);
+	return NewVoice;
+}
+
+bool UXRAudioPoolSubsystem::IsHandleCurrent(const FXRAudioVoiceHandle& InHandle) const
+{
+	return InHandle.IsSet()
+		&& Voices.IsValidIndex(InHandle.VoiceIndex)
+		&& IsValid(Voices[InHandle.VoiceIndex])
+		&& VoiceSerials[InHandle.VoiceIndex] == InHandle.Serial;
+}
+
+// Audio is pointless without an audio device, this includes every dedicated server
+bool UXRAudioPoolSubsystem::CanPlayAudio() const
+{
+	const UWorld* World = GetWorld();
+	if (!World || World->GetNetMode() == NM_DedicatedServer)
+	{
+		return false;
+	}
+	return FApp::CanEverRenderAudio() && World->GetAudioDeviceRaw() != nullptr;
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Utility
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+int32 UXRAudioPoolSubsystem::GetNumVoices() const
+{
+	return Voices.Num();
+}
+
+int32 UXRAudioPoolSubsystem::GetNumActiveVoices() const
+{
+	int32 NumActive = 0;
+	for (const UAudioComponent* Voice : Voices)
+	{
+		if (IsValid(Voice) && Voice->IsPlaying())
+		{
+			NumActive++;
+		}
+	}
+	return NumActive;
+}
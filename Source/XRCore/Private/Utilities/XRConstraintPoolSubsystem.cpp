@@ -0,0 +1,287 @@
+#include "Utilities/XRConstraintPoolSubsystem.h"
+#include "Core/XRCoreSettings.h"
+
+#include "Engine/World.h"
+#include "HAL/PlatformTime.h"
+#include "PhysicsEngine/BodyInstance.h"
+
+void UXRConstraintPoolSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// Constraint instances are configured up front, acquiring only binds them to the bodies
+	PoolSize = FMath::Max(GetDefault<UXRCoreSettings>()->ConstraintPoolSize, 1);
+	Entries.SetNum(PoolSize);
+	for (FXRPooledConstraint& Entry : Entries)
+	{
+		Entry.Constraint = MakeUnique<FConstraintInstance>();
+		ConfigureConstraintProfile(*Entry.Constraint);
+	}
+}
+
+void UXRConstraintPoolSubsystem::Deinitialize()
+{
+	for (FXRPooledConstraint& Entry : Entries)
+	{
+		TermJoint(Entry);
+	}
+	Entries.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UXRConstraintPoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Acquire / Release
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+FXRConstraintHandle UXRConstraintPoolSubsystem::AcquireConstraint(UPrimitiveComponent* InInteractor, UPrimitiveComponent* InMesh)
+{
+	if (!InInteractor || !InMesh)
+	{
+		return FXRConstraintHandle();
+	}
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	int32 EntryIndex = FindReusableIndex(InInteractor, InMesh);
+	if (EntryIndex != INDEX_NONE)
+	{
+		// Same bodies as before, only the target and the drives change
+		const UXRCoreSettings* Settings = GetDefault<UXRCoreSettings>();
+		FConstraintInstance& Constraint = *Entries[EntryIndex].Constraint;
+		Constraint.SetRefFrame(EConstraintFrame::Frame2, InMesh->GetComponentTransform().GetRelativeTransform(InInteractor->GetComponentTransform()));
+		Constraint.SetLinearDriveParams(Settings->GrabLinearDriveStiffness, Settings->GrabLinearDriveDamping, 0.0f);
+		Constraint.SetAngularDriveParams(Settings->GrabAngularDriveStiffness, Settings->GrabAngularDriveDamping, 0.0f);
+		SetDrivesEnabled(Constraint, true);
+		Constraint.SetDisableCollision(true);
+		Stats.NumReused++;
+	}
+	else
+	{
+		EntryIndex = FindFreeIndex();
+		if (!InitJoint(Entries[EntryIndex], InInteractor, InMesh))
+		{
+			return FXRConstraintHandle();
+		}
+		Stats.NumCreated++;
+	}
+
+	FXRPooledConstraint& Entry = Entries[EntryIndex];
+	Entry.bInUse = true;
+	Entry.Serial = NextSerial++;
+
+	const float ElapsedMicroseconds = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0;
+	Stats.AverageAcquireMicroseconds += (ElapsedMicroseconds - Stats.AverageAcquireMicroseconds) / ++NumAcquireSamples;
+
+	FXRConstraintHandle OutHandle;
+	OutHandle.ConstraintIndex = EntryIndex;
+	OutHandle.Serial = Entry.Serial;
+	return OutHandle;
+}
+
+void UXRConstraintPoolSubsystem::ReleaseConstraint(FXRConstraintHandle& InOutHandle)
+{
+	FXRPooledConstraint* Entry = GetEntry(InOutHandle);
+	InOutHandle.Reset();
+	if (!Entry)
+	{
+		return;
+	}
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	// The joint stays in the scene with free motion, no drives and collision between the bodies until it is reused or evicted
+	FConstraintInstance& Constraint = *Entry->Constraint;
+	SetDrivesEnabled(Constraint, false);
+	Constraint.SetLinearDriveParams(0.0f, 0.0f, 0.0f);
+	Constraint.SetAngularDriveParams(0.0f, 0.0f, 0.0f);
+	Constraint.SetDisableCollision(false);
+	Entry->bInUse = false;
+	Entry->Serial = 0;
+	Entry->LastReleaseTime = GetWorld()->GetTimeSeconds();
+
+	const float ElapsedMicroseconds = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0;
+	Stats.AverageReleaseMicroseconds += (ElapsedMicroseconds - Stats.AverageReleaseMicroseconds) / ++NumReleaseSamples;
+}
+
+void UXRConstraintPoolSubsystem::SetDriveParams(const FXRConstraintHandle& InHandle, float InLinearStiffness, float InLinearDamping, float InAngularStiffness, float InAngularDamping)
+{
+	if (FXRPooledConstraint* Entry = GetEntry(InHandle))
+	{
+		Entry->Constraint->SetLinearDriveParams(InLinearStiffness, InLinearDamping, 0.0f);
+		Entry->Constraint->SetAngularDriveParams(InAngularStiffness, InAngularDamping, 0.0f);
+	}
+}
+
+void UXRConstraintPoolSubsystem::SetRelativeTarget(const FXRConstraintHandle& InHandle, const FTransform& InMeshRelativeToInteractor)
+{
+	if (FXRPooledConstraint* Entry = GetEntry(InHandle))
+	{
+		Entry->Constraint->SetRefFrame(EConstraintFrame::Frame2, InMeshRelativeToInteractor);
+	}
+}
+
+FXRConstraintPoolStats UXRConstraintPoolSubsystem::GetPoolStats() const
+{
+	FXRConstraintPoolStats OutStats = Stats;
+	OutStats.NumConstraints = 0;
+	OutStats.NumInUse = 0;
+	for (const FXRPooledConstraint& Entry : Entries)
+	{
+		if (Entry.Constraint && Entry.Constraint->IsValidConstraintInstance())
+		{
+			OutStats.NumConstraints++;
+		}
+		if (Entry.bInUse)
+		{
+			OutStats.NumInUse++;
+		}
+	}
+	return OutStats;
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Pool
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+int32 UXRConstraintPoolSubsystem::FindReusableIndex(UPrimitiveComponent* InInteractor, UPrimitiveComponent* InMesh) const
+{
+	for (int32 Index = 0; Index < Entries.Num(); Index++)
+	{
+		const FXRPooledConstraint& Entry = Entries[Index];
+		if (!Entry.bInUse && Entry.Interactor == InInteractor && Entry.Mesh == InMesh && Entry.Constraint->IsValidConstraintInstance())
+		{
+			return Index;
+		}
+	}
+	return INDEX_NONE;
+}
+
+// An unbound entry, otherwise the least recently released joint. The pool only grows past its size while all joints are in use.
+int32 UXRConstraintPoolSubsystem::FindFreeIndex()
+{
+	int32 OldestIdleIndex = INDEX_NONE;
+	for (int32 Index = 0; Index < Entries.Num(); Index++)
+	{
+		const FXRPooledConstraint& Entry = Entries[Index];
+		if (Entry.bInUse)
+		{
+			continue;
+		}
+		if (!Entry.Constraint->IsValidConstraintInstance())
+		{
+			return Index;
+		}
+		if (OldestIdleIndex == INDEX_NONE || Entry.LastReleaseTime < Entries[OldestIdleIndex].LastReleaseTime)
+		{
+			OldestIdleIndex = Index;
+		}
+	}
+
+	if (OldestIdleIndex != INDEX_NONE && Entries.Num() >= PoolSize)
+	{
+		TermJoint(Entries[OldestIdleIndex]);
+		Stats.NumEvicted++;
+		return OldestIdleIndex;
+	}
+
+	FXRPooledConstraint& NewEntry = Entries.AddDefaulted_GetRef();
+	NewEntry.Constraint = MakeUnique<FConstraintInstance>();
+	ConfigureConstraintProfile(*NewEntry.Constraint);
+	return Entries.Num() - 1;
+}
+
+UXRConstraintPoolSubsystem::FXRPooledConstraint* UXRConstraintPoolSubsystem::GetEntry(const FXRConstraintHandle& InHandle)
+{
+	if (!InHandle.IsSet() || !Entries.IsValidIndex(InHandle.ConstraintIndex))
+	{
+		return nullptr;
+	}
+	FXRPooledConstraint& Entry = Entries[InHandle.ConstraintIndex];
+	return (Entry.bInUse && Entry.Serial == InHandle.Serial) ? &Entry : nullptr;
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Joints
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+bool UXRConstraintPoolSubsystem::InitJoint(FXRPooledConstraint& InEntry, UPrimitiveComponent* InInteractor, UPrimitiveComponent* InMesh)
+{
+	FBodyInstance* MeshBody = InMesh->GetBodyInstance();
+	FBodyInstance* InteractorBody = InInteractor->GetBodyInstance();
+	if (!MeshBody || !MeshBody->IsValidBodyInstance() || !InteractorBody || !InteractorBody->IsValidBodyInstance())
+	{
+		return false;
+	}
+
+	// Frame1 is the mesh origin, Frame2 the target pose of the mesh in interactor space
+	FConstraintInstance& Constraint = *InEntry.Constraint;
+	const UXRCoreSettings* Settings = GetDefault<UXRCoreSettings>();
+	Constraint.SetRefFrame(EConstraintFrame::Frame1, FTransform::Identity);
+	Constraint.SetRefFrame(EConstraintFrame::Frame2, InMesh->GetComponentTransform().GetRelativeTransform(InInteractor->GetComponentTransform()));
+	Constraint.SetLinearDriveParams(Settings->GrabLinearDriveStiffness, Settings->GrabLinearDriveDamping, 0.0f);
+	Constraint.SetAngularDriveParams(Settings->GrabAngularDriveStiffness, Settings->GrabAngularDriveDamping, 0.0f);
+	SetDrivesEnabled(Constraint, true);
+	// An evicted joint keeps the collision setting of its release
+	Constraint.SetDisableCollision(true);
+	Constraint.InitConstraint(MeshBody, InteractorBody, 1.0f, InMesh);
+	if (!Constraint.IsValidConstraintInstance())
+	{
+		return false;
+	}
+
+	InEntry.Interactor = InInteractor;
+	InEntry.Mesh = InMesh;
+	InInteractor->OnComponentPhysicsStateChanged.AddUniqueDynamic(this, &UXRConstraintPoolSubsystem::OnPooledComponentPhysicsStateChanged);
+	InMesh->OnComponentPhysicsStateChanged.AddUniqueDynamic(this, &UXRConstraintPoolSubsystem::OnPooledComponentPhysicsStateChanged);
+	return true;
+}
+
+void UXRConstraintPoolSubsystem::TermJoint(FXRPooledConstraint& InEntry)
+{
+	if (InEntry.Constraint)
+	{
+		InEntry.Constraint->TermConstraint();
+	}
+	InEntry.Interactor = nullptr;
+	InEntry.Mesh = nullptr;
+	InEntry.bInUse = false;
+	InEntry.Serial = 0;
+}
+
+void UXRConstraintPoolSubsystem::ConfigureConstraintProfile(FConstraintInstance& InConstraint) const
+{
+	InConstraint.SetLinearXLimit(ELinearConstraintMotion::LCM_Free, 0.0f);
+	InConstraint.SetLinearYLimit(ELinearConstraintMotion::LCM_Free, 0.0f);
+	InConstraint.SetLinearZLimit(ELinearConstraintMotion::LCM_Free, 0.0f);
+	InConstraint.SetAngularSwing1Limit(EAngularConstraintMotion::ACM_Free, 0.0f);
+	InConstraint.SetAngularSwing2Limit(EAngularConstraintMotion::ACM_Free, 0.0f);
+	InConstraint.SetAngularTwistLimit(EAngularConstraintMotion::ACM_Free, 0.0f);
+	InConstraint.SetAngularDriveMode(EAngularDriveMode::SLERP);
+	InConstraint.SetDisableCollision(true);
+	SetDrivesEnabled(InConstraint, false);
+}
+
+void UXRConstraintPoolSubsystem::SetDrivesEnabled(FConstraintInstance& InConstraint, bool bInEnabled) const
+{
+	InConstraint.SetLinearPositionDrive(bInEnabled, bInEnabled, bInEnabled);
+	InConstraint.SetLinearVelocityDrive(bInEnabled, bInEnabled, bInEnabled);
+	InConstraint.SetOrientationDriveSLERP(bInEnabled);
+	InConstraint.SetAngularVelocityDriveSLERP(bInEnabled);
+}
+
+// Bodies are about to be destroyed, the joints bound to them have to go first
+void UXRConstraintPoolSubsystem::OnPooledComponentPhysicsStateChanged(UPrimitiveComponent* InChangedComponent, EComponentPhysicsStateChange InStateChange)
+{
+	if (InStateChange != EComponentPhysicsStateChange::Destroyed)
+	{
+		return;
+	}
+	for (FXRPooledConstraint& Entry : Entries)
+	{
+		if (Entry.Interactor == InChangedComponent || Entry.Mesh == InChangedComponent)
+		{
+			TermJoint(Entry);
+		}
+	}
+}
@@ -0,0 +1,339 @@
+#include "CoreMinimal.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include "Connections/XRConnectorComponent.h"
+#include "Core/XRCoreHandComponent.h"
+#include "Core/XRLaserTargetingSubsystem.h"
+#include "Interactions/XRInteractableInstances.h"
+#include "Interactions/XRInteractionComponent.h"
+#include "Utilities/XRAudioPoolSubsystem.h"
+#include "Utilities/XRConstraintPoolSubsystem.h"
+#include "Utilities/XRCoreNetStats.h"
+#include "Utilities/XRDebugRegistrySubsystem.h"
+#include "Utilities/XRGrabFollowSubsystem.h"
+#include "Utilities/XRHighlightComponent.h"
+#include "Utilities/XRReplicatedPhysicsComponent.h"
+
+#include "DrawDebugHelpers.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+// World stats
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+namespace XRCoreDebug
+{
+	// Snapshot of the counters XRCore components maintain, gathered on demand so nothing is paid while no one is looking
+	struct FXRCoreWorldStats
+	{
+		int32 NumInteractions = 0;
+		int32 NumHoveredInteractions = 0;
+		int32 NumActiveInteractions = 0;
+		int32 NumInteractableItems = 0;
+		int32 NumPromotedItems = 0;
+		int32 NumActiveHighlights = 0;
+		int32 NumVisibleHolograms = 0;
+		int32 NumPhysicsComponents = 0;
+		int32 NumDormantPhysicsComponents = 0;
+		float AverageSnapshotRate = 0.0f;
+		float MaxInterpolationError = 0.0f;
+		int32 NumAudioVoices = 0;
+		int32 NumActiveAudioVoices = 0;
+		int32 NumConstraints = 0;
+		int32 NumConstraintsInUse = 0;
+		int32 NumNativeLasers = 0;
+		int32 NumGrabFollowers = 0;
+	};
+
+	// XRCore objects of the world that have begun play, see UXRDebugRegistrySubsystem
+	template<typename TObject>
+	void ForEachRegistered(const UWorld* InWorld, TFunctionRef<void(TObject*)> InFunction)
+	{
+		if (const UXRDebugRegistrySubsystem* Registry = InWorld ? InWorld->GetSubsystem<UXRDebugRegistrySubsystem>() : nullptr)
+		{
+			Registry->ForEach<TObject>(InFunction);
+		}
+	}
+
+	FXRCoreWorldStats GatherWorldStats(UWorld* InWorld)
+	{
+		FXRCoreWorldStats Stats;
+
+		ForEachRegistered<UXRInteractionComponent>(InWorld, [&Stats](UXRInteractionComponent* Interaction)
+		{
+			Stats.NumInteractions++;
+			if (Interaction->NumHoveringInteractors() > 0)
+			{
+				Stats.NumHoveredInteractions++;
+			}
+			if (Interaction->IsInteractedWith())
+			{
+				Stats.NumActiveInteractions++;
+			}
+		});
+
+		ForEachRegistered<AXRInteractableInstances>(InWorld, [&Stats](AXRInteractableInstances* InteractableInstances)
+		{
+			Stats.NumInteractableItems += InteractableInstances->GetNumItems();
+			Stats.NumPromotedItems += InteractableInstances->GetNumPromotedItems();
+		});
+
+		ForEachRegistered<UXRHighlightComponent>(InWorld, [&Stats](UXRHighlightComponent* Highlight)
+		{
+			if (Highlight->GetHighlightState() > KINDA_SMALL_NUMBER)
+			{
+				Stats.NumActiveHighlights++;
+			}
+		});
+
+		ForEachRegistered<UXRConnectorComponent>(InWorld, [&Stats](UXRConnectorComponent* Connector)
+		{
+			Stats.NumVisibleHolograms += Connector->GetNumVisibleHolograms();
+		});
+
+		float TotalSnapshotRate = 0.0f;
+		ForEachRegistered<UXRReplicatedPhysicsComponent>(InWorld, [&Stats, &TotalSnapshotRate](UXRReplicatedPhysicsComponent* Physics)
+		{
+			Stats.NumPhysicsComponents++;
+			if (Physics->IsNetDormant())
+			{
+				Stats.NumDormantPhysicsComponents++;
+			}
+			TotalSnapshotRate += Physics->GetSnapshotRate();
+			Stats.MaxInterpolationError = FMath::Max(Stats.MaxInterpolationError, Physics->GetInterpolationError());
+		});
+		if (Stats.NumPhysicsComponents > 0)
+		{
+			Stats.AverageSnapshotRate = TotalSnapshotRate / Stats.NumPhysicsComponents;
+		}
+
+		if (const UXRAudioPoolSubsystem* AudioPool = InWorld->GetSubsystem<UXRAudioPoolSubsystem>())
+		{
+			Stats.NumAudioVoices = AudioPool->GetNumVoices();
+			Stats.NumActiveAudioVoices = AudioPool->GetNumActiveVoices();
+		}
+		if (const UXRConstraintPoolSubsystem* ConstraintPool = InWorld->GetSubsystem<UXRConstraintPoolSubsystem>())
+		{
+			const FXRConstraintPoolStats PoolStats = ConstraintPool->GetPoolStats();
+			Stats.NumConstraints = PoolStats.NumConstraints;
+			Stats.NumConstraintsInUse = PoolStats.NumInUse;
+		}
+		if (const UXRLaserTargetingSubsystem* LaserTargeting = InWorld->GetSubsystem<UXRLaserTargetingSubsystem>())
+		{
+			Stats.NumNativeLasers = LaserTargeting->GetTargetingStats().NumRegisteredLasers;
+		}
+		if (const UXRGrabFollowSubsystem* GrabFollow = InWorld->GetSubsystem<UXRGrabFollowSubsystem>())
+		{
+			Stats.NumGrabFollowers = GrabFollow->GetNumFollowers();
+		}
+		return Stats;
+	}
+
+	TArray<FString> FormatWorldStats(const FXRCoreWorldStats& InStats)
+	{
+		return {
+			FString::Printf(TEXT("Interactions %d  hovered %d  active %d"), InStats.NumInteractions, InStats.NumHoveredInteractions, InStats.NumActiveInteractions),
+			FString::Printf(TEXT("Interactable items %d  promoted %d"), InStats.NumInteractableItems, InStats.NumPromotedItems),
+			FString::Printf(TEXT("Highlights active %d  holograms visible %d"), InStats.NumActiveHighlights, InStats.NumVisibleHolograms),
+			FString::Printf(TEXT("Physics %d  awake %d  dormant %d  snapshots avg %.1f/s  max interp error %.1f cm"), InStats.NumPhysicsComponents,
+				InStats.NumPhysicsComponents - InStats.NumDormantPhysicsComponents, InStats.NumDormantPhysicsComponents, InStats.AverageSnapshotRate, InStats.MaxInterpolationError),
+			FString::Printf(TEXT("Pools: audio %d/%d  constraints %d/%d  lasers %d  grab follow %d"), InStats.NumActiveAudioVoices, InStats.NumAudioVoices,
+				InStats.NumConstraintsInUse, InStats.NumConstraints, InStats.NumNativeLasers, InStats.NumGrabFollowers),
+		};
+	}
+
+	// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+	// Console commands
+	// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+	FAutoConsoleCommandWithWorldArgsAndOutputDevice StatsCommand(
+		TEXT("xrcore.stats"),
+		TEXT("Print XRCore interaction, highlight, hologram, physics and pool counts of the current world."),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+		{
+			if (!World)
+			{
+				Ar.Log(TEXT("xrcore.stats: no world."));
+				return;
+			}
+			for (const FString& Line : FormatWorldStats(GatherWorldStats(World)))
+			{
+				Ar.Log(Line);
+			}
+		}));
+
+	FAutoConsoleCommandWithWorldArgsAndOutputDevice NetCommand(
+		TEXT("xrcore.net"),
+		TEXT("Print XRCore traffic per feature, snapshot rate and interpolation error per physics actor and send rate per hand. Args: [reset | track on|off]"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+		{
+			if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+			{
+				FXRCoreNetStats::Reset();
+				Ar.Log(TEXT("xrcore.net: counters reset."));
+				return;
+			}
+			if (Args.Num() > 0 && Args[0] == TEXT("track"))
+			{
+				const bool bTrack = Args.Num() < 2 || Args[1] == TEXT("on") || Args[1] == TEXT("1");
+				FXRCoreNetStats::SetTrackingEnabled(bTrack);
+				Ar.Logf(TEXT("xrcore.net: byte and snapshot latency tracking %s."), bTrack ? TEXT("on") : TEXT("off"));
+				return;
+			}
+
+			for (int32 Index = 0; Index < static_cast<int32>(EXRNetFeature::Num); ++Index)
+			{
+				const EXRNetFeature Feature = static_cast<EXRNetFeature>(Index);
+				const FXRNetFeatureStats FeatureStats = FXRCoreNetStats::GetFeatureStats(Feature);
+				Ar.Logf(TEXT("%-24s messages %8lld  bytes %10lld%s"), FXRCoreNetStats::GetFeatureName(Feature), FeatureStats.NumMessages, FeatureStats.NumBytes,
+					FeatureStats.NumEstimatedMessages > 0 ? TEXT(" (estimated)") : TEXT(""));
+			}
+			if (FXRCoreNetStats::IsTrackingEnabled())
+			{
+				Ar.Logf(TEXT("Snapshot to visual latency avg %.1f ms, max %.1f ms"), FXRCoreNetStats::GetAverageSnapshotLatency() * 1000.0, FXRCoreNetStats::GetMaxSnapshotLatency() * 1000.0);
+			}
+			else
+			{
+				Ar.Log(TEXT("Bytes and snapshot latency are tracked during xrcore.netbench runs or after xrcore.net track on."));
+			}
+
+			if (!World)
+			{
+				return;
+			}
+			ForEachRegistered<UXRReplicatedPhysicsComponent>(World, [&Ar](UXRReplicatedPhysicsComponent* Physics)
+			{
+				Ar.Logf(TEXT("%-40s %6.1f snapshots/s  interp error %6.1f cm%s"), *GetNameSafe(Physics->GetOwner()), Physics->GetSnapshotRate(),
+					Physics->GetInterpolationError(), Physics->IsNetDormant() ? TEXT("  dormant") : TEXT(""));
+			});
+			ForEachRegistered<UXRCoreHandComponent>(World, [&Ar](UXRCoreHandComponent* Hand)
+			{
+				const FXRHandReplicationMetrics Metrics = Hand->GetReplicationMetrics();
+				if (Metrics.NumSamples > 0)
+				{
+					Ar.Logf(TEXT("%-40s %6.1f sends/s  avg error %.2f cm / %.2f deg"), *GetNameSafe(Hand->GetOwner()), Metrics.SendRate,
+						Metrics.AverageLocationError, Metrics.AverageRotationError);
+				}
+			});
+		}));
+
+	// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+	// Debug draw
+	// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+	FDelegateHandle PostActorTickHandle;
+
+	float DebugDrawInterval = 0.25f;
+	FAutoConsoleVariableRef CVarDebugDrawInterval(
+		TEXT("xrcore.debug.draw.interval"),
+		DebugDrawInterval,
+		TEXT("Seconds between refreshes of the xrcore.debug.draw overlay, it is kept on screen in between."));
+
+	float DebugDrawLabelDistance = 1000.0f;
+	FAutoConsoleVariableRef CVarDebugDrawLabelDistance(
+		TEXT("xrcore.debug.draw.distance"),
+		DebugDrawLabelDistance,
+		TEXT("Only label physics actors within this distance (cm) of the local view."));
+
+	int32 DebugDrawMaxLabels = 32;
+	FAutoConsoleVariableRef CVarDebugDrawMaxLabels(
+		TEXT("xrcore.debug.draw.maxlabels"),
+		DebugDrawMaxLabels,
+		TEXT("Label at most this many physics actors, the closest to the local view."));
+
+	// Real time of the last refresh per world, PIE clients each draw their own overlay
+	TMap<TWeakObjectPtr<UWorld>, double> LastDrawTimes;
+
+	void DrawWorldStats(UWorld* InWorld, ELevelTick InTickType, float InDeltaSeconds)
+	{
+		if (!InWorld || !InWorld->IsGameWorld() || InWorld->GetNetMode() == NM_DedicatedServer)
+		{
+			return;
+		}
+		const double Now = InWorld->GetRealTimeSeconds();
+		double& LastDrawTime = LastDrawTimes.FindOrAdd(InWorld, -DBL_MAX);
+		if (Now - LastDrawTime < DebugDrawInterval)
+		{
+			return;
+		}
+		LastDrawTime = Now;
+		const float Duration = FMath::Max(DebugDrawInterval, 0.0f);
+
+		FVector ViewLocation = FVector::ZeroVector;
+		FRotator ViewRotation = FRotator::ZeroRotator;
+		const APlayerController* PlayerController = GEngine ? GEngine->GetFirstLocalPlayerController(InWorld) : nullptr;
+		if (PlayerController)
+		{
+			PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+			// The closest physics actors within range, labels attached to the actor so they follow it between refreshes
+			TArray<TPair<double, UXRReplicatedPhysicsComponent*>> Labeled;
+			const double MaxDistanceSquared = FMath::Square(static_cast<double>(DebugDrawLabelDistance));
+			ForEachRegistered<UXRReplicatedPhysicsComponent>(InWorld, [&Labeled, &ViewLocation, MaxDistanceSquared](UXRReplicatedPhysicsComponent* Physics)
+			{
+				const AActor* Owner = Physics->GetOwner();
+				const double DistanceSquared = Owner ? FVector::DistSquared(Owner->GetActorLocation(), ViewLocation) : MaxDistanceSquared;
+				if (DistanceSquared < MaxDistanceSquared)
+				{
+					Labeled.Emplace(DistanceSquared, Physics);
+				}
+			});
+			if (Labeled.Num() > DebugDrawMaxLabels)
+			{
+				Labeled.Sort([](const TPair<double, UXRReplicatedPhysicsComponent*>& A, const TPair<double, UXRReplicatedPhysicsComponent*>& B) { return A.Key < B.Key; });
+				Labeled.SetNum(FMath::Max(DebugDrawMaxLabels, 0));
+			}
+			for (const TPair<double, UXRReplicatedPhysicsComponent*>& Entry : Labeled)
+			{
+				const UXRReplicatedPhysicsComponent* Physics = Entry.Value;
+				const FString Text = FString::Printf(TEXT("%.1f/s  %.1f cm%s"), Physics->GetSnapshotRate(), Physics->GetInterpolationError(),
+					Physics->IsNetDormant() ? TEXT("  zZ") : TEXT(""));
+				DrawDebugString(InWorld, FVector(0.0, 0.0, 20.0), Text, Physics->GetOwner(), Physics->IsNetDormant() ? FColor::Silver : FColor::Cyan, Duration, false, 1.0f);
+			}
+		}
+
+		// Only locally controlled hands collect send metrics, so there are one or two of these
+		ForEachRegistered<UXRCoreHandComponent>(InWorld, [InWorld, Duration](UXRCoreHandComponent* Hand)
+		{
+			const FXRHandReplicationMetrics Metrics = Hand->GetReplicationMetrics();
+			if (Metrics.NumSamples > 0 && Hand->GetOwner())
+			{
+				DrawDebugString(InWorld, FVector(0.0, 0.0, 10.0), FString::Printf(TEXT("%.1f sends/s"), Metrics.SendRate), Hand->GetOwner(),
+					FColor::Yellow, Duration, false, 1.0f);
+			}
+		});
+
+		if (GEngine)
+		{
+			const TArray<FString> Lines = FormatWorldStats(GatherWorldStats(InWorld));
+			for (int32 Index = 0; Index < Lines.Num(); ++Index)
+			{
+				// Fixed keys replace the previous refresh's lines instead of stacking up
+				GEngine->AddOnScreenDebugMessage(static_cast<uint64>(0x58524344) + Index, Duration, FColor::Cyan, Lines[Index]);
+			}
+		}
+	}
+
+	int32 DebugDraw = 0;
+	FAutoConsoleVariableRef CVarDebugDraw(
+		TEXT("xrcore.debug.draw"),
+		DebugDraw,
+		TEXT("Draw XRCore snapshot rates, interpolation errors, hand send rates and world counts. 0: off, 1: on"),
+		FConsoleVariableDelegate::CreateLambda([](IConsoleVariable* InVariable)
+		{
+			if (DebugDraw != 0 && !PostActorTickHandle.IsValid())
+			{
+				PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddStatic(&DrawWorldStats);
+			}
+			else if (DebugDraw == 0 && PostActorTickHandle.IsValid())
+			{
+				FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+				PostActorTickHandle.Reset();
+				LastDrawTimes.Reset();
+			}
+		}));
+}
+
+#endif
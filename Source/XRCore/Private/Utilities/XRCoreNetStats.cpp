@@ -0,0 +1,209 @@
+#include "Utilities/XRCoreNetStats.h"
+#include "Core/XRCoreStats.h"
+
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "GameFramework/Actor.h"
+#include "HAL/PlatformTime.h"
+#include "Net/NetworkObjectList.h"
+#include "Serialization/BitWriter.h"
+#include "UObject/UnrealType.h"
+
+namespace XRCoreNetStats
+{
+	// Send times older than this are of no use, the slot is treated as empty
+	constexpr double MaxSnapshotAge = 5.0;
+
+	// Consecutive snapshots of one actor take consecutive slots, actors start at scattered offsets
+	int32 GetSnapshotSlot(uint32 InActorKey, uint32 InSnapshotId, int32 InNumSlots)
+	{
+		return static_cast<int32>((InSnapshotId + InActorKey * 2654435761u) % static_cast<uint32>(InNumSlots));
+	}
+}
+
+FXRNetFeatureStats FXRCoreNetStats::FeatureStats[static_cast<int32>(EXRNetFeature::Num)] = {};
+double FXRCoreNetStats::TotalSnapshotLatency = 0.0;
+double FXRCoreNetStats::MaxSnapshotLatency = 0.0;
+int64 FXRCoreNetStats::NumSnapshotLatencySamples = 0;
+bool FXRCoreNetStats::bTrackingEnabled = false;
+FXRCoreNetStats::FSnapshotSendTime FXRCoreNetStats::SnapshotSendTimes[FXRCoreNetStats::NumSnapshotSendTimes] = {};
+
+void FXRCoreNetStats::RecordMessage(EXRNetFeature InFeature)
+{
+	FeatureStats[static_cast<int32>(InFeature)].NumMessages++;
+
+	switch (InFeature)
+	{
+		case EXRNetFeature::HandData: INC_DWORD_STAT(STAT_XRCore_HandDataSends); break;
+		case EXRNetFeature::HandJoints: INC_DWORD_STAT(STAT_XRCore_HandJointSends); break;
+		case EXRNetFeature::PhysicsSnapshot: INC_DWORD_STAT(STAT_XRCore_PhysicsSnapshots); break;
+		case EXRNetFeature::InteractionMulticast: INC_DWORD_STAT(STAT_XRCore_InteractionMulticasts); break;
+		case EXRNetFeature::LaserInput: INC_DWORD_STAT(STAT_XRCore_LaserInputPackets); break;
+		case EXRNetFeature::TriggerState: INC_DWORD_STAT(STAT_XRCore_TriggerStateChanges); break;
+		case EXRNetFeature::ConnectorState: INC_DWORD_STAT(STAT_XRCore_ConnectorStateChanges); break;
+		default: break;
+	}
+}
+
+void FXRCoreNetStats::RecordBytes(EXRNetFeature InFeature, int32 InNumBytes, int32 InNumReceivers, bool bInEstimated)
+{
+	FXRNetFeatureStats& Stats = FeatureStats[static_cast<int32>(InFeature)];
+	Stats.NumBytes += static_cast<int64>(InNumBytes) * InNumReceivers;
+	if (bInEstimated)
+	{
+		Stats.NumEstimatedMessages++;
+	}
+}
+
+int32 FXRCoreNetStats::GetNumServerReceivers(AActor* InActor)
+{
+	const UNetDriver* NetDriver = InActor ? InActor->GetNetDriver() : nullptr;
+	return NetDriver && !NetDriver->IsServer() ? 1 : 0;
+}
+
+int32 FXRCoreNetStats::GetNumClientReceivers(AActor* InActor, bool bInSkipOwner)
+{
+	UNetDriver* NetDriver = InActor ? InActor->GetNetDriver() : nullptr;
+	if (!NetDriver || !NetDriver->IsServer())
+	{
+		return 0;
+	}
+
+	const TWeakObjectPtr<AActor> WeakActor(InActor);
+	const UNetConnection* OwnerConnection = bInSkipOwner ? InActor->GetNetConnection() : nullptr;
+	const FNetworkObjectInfo* ObjectInfo = NetDriver->FindNetworkObjectInfo(InActor);
+	int32 NumReceivers = 0;
+	for (UNetConnection* Connection : NetDriver->ClientConnections)
+	{
+		if (!Connection || Connection == OwnerConnection)
+		{
+			continue;
+		}
+		// A dormant actor has no open channel, the connection still gets the change once the actor is flushed
+		if (Connection->FindActorChannelRef(WeakActor) || (ObjectInfo && ObjectInfo->DormantConnections.Contains(Connection)))
+		{
+			NumReceivers++;
+		}
+	}
+	return NumReceivers;
+}
+
+int32 FXRCoreNetStats::GetNetSerializedBytes(const UScriptStruct* InStruct, void* InData)
+{
+	if (!InStruct || !InData)
+	{
+		return 0;
+	}
+
+	FBitWriter Writer(0, true);
+	UScriptStruct::ICppStructOps* StructOps = InStruct->GetCppStructOps();
+	if (StructOps && StructOps->HasNetSerializer())
+	{
+		bool bSuccess = false;
+		StructOps->NetSerialize(Writer, nullptr, bSuccess, InData);
+	}
+	else
+	{
+		for (TFieldIterator<FProperty> It(InStruct); It; ++It)
+		{
+			It->NetSerializeItem(Writer, nullptr, It->ContainerPtrToValuePtr<void>(InData));
+		}
+	}
+	return static_cast<int32>(Writer.GetNumBytes());
+}
+
+void FXRCoreNetStats::RecordSnapshotLatency(double InSeconds)
+{
+	TotalSnapshotLatency += InSeconds;
+	MaxSnapshotLatency = FMath::Max(MaxSnapshotLatency, InSeconds);
+	NumSnapshotLatencySamples++;
+}
+
+void FXRCoreNetStats::RecordSnapshotSent(uint32 InActorKey, uint32 InSnapshotId)
+{
+	if (!bTrackingEnabled)
+	{
+		return;
+	}
+	FSnapshotSendTime& Slot = SnapshotSendTimes[XRCoreNetStats::GetSnapshotSlot(InActorKey, InSnapshotId, NumSnapshotSendTimes)];
+	Slot.ActorKey = InActorKey;
+	Slot.SnapshotId = InSnapshotId;
+	Slot.SendTime = FPlatformTime::Seconds();
+}
+
+// Kept after the first client, every client showing the snapshot is a sample
+void FXRCoreNetStats::RecordSnapshotShown(uint32 InActorKey, uint32 InSnapshotId)
+{
+	if (!bTrackingEnabled)
+	{
+		return;
+	}
+	const FSnapshotSendTime& Slot = SnapshotSendTimes[XRCoreNetStats::GetSnapshotSlot(InActorKey, InSnapshotId, NumSnapshotSendTimes)];
+	const double Latency = FPlatformTime::Seconds() - Slot.SendTime;
+	if (Slot.SendTime > 0.0 && Slot.ActorKey == InActorKey && Slot.SnapshotId == InSnapshotId && Latency <= XRCoreNetStats::MaxSnapshotAge)
+	{
+		RecordSnapshotLatency(Latency);
+	}
+}
+
+void FXRCoreNetStats::SetTrackingEnabled(bool bInEnabled)
+{
+	if (bTrackingEnabled != bInEnabled)
+	{
+		bTrackingEnabled = bInEnabled;
+		for (FSnapshotSendTime& Slot : SnapshotSendTimes)
+		{
+			Slot = FSnapshotSendTime();
+		}
+	}
+}
+
+bool FXRCoreNetStats::IsTrackingEnabled()
+{
+	return bTrackingEnabled;
+}
+
+FXRNetFeatureStats FXRCoreNetStats::GetFeatureStats(EXRNetFeature InFeature)
+{
+	return FeatureStats[static_cast<int32>(InFeature)];
+}
+
+double FXRCoreNetStats::GetAverageSnapshotLatency()
+{
+	return NumSnapshotLatencySamples > 0 ? TotalSnapshotLatency / NumSnapshotLatencySamples : 0.0;
+}
+
+double FXRCoreNetStats::GetMaxSnapshotLatency()
+{
+	return MaxSnapshotLatency;
+}
+
+const TCHAR* FXRCoreNetStats::GetFeatureName(EXRNetFeature InFeature)
+{
+	switch (InFeature)
+	{
+		case EXRNetFeature::HandData: return TEXT("HandData");
+		case EXRNetFeature::HandJoints: return TEXT("HandJoints");
+		case EXRNetFeature::PhysicsSnapshot: return TEXT("PhysicsSnapshot");
+		case EXRNetFeature::InteractionMulticast: return TEXT("InteractionMulticast");
+		case EXRNetFeature::LaserInput: return TEXT("LaserInput");
+		case EXRNetFeature::TriggerState: return TEXT("TriggerState");
+		case EXRNetFeature::ConnectorState: return TEXT("ConnectorState");
+		default: return TEXT("Unknown");
+	}
+}
+
+void FXRCoreNetStats::Reset()
+{
+	for (FXRNetFeatureStats& Stats : FeatureStats)
+	{
+		Stats = FXRNetFeatureStats();
+	}
+	TotalSnapshotLatency = 0.0;
+	MaxSnapshotLatency = 0.0;
+	NumSnapshotLatencySamples = 0;
+	for (FSnapshotSendTime& Slot : SnapshotSendTimes)
+	{
+		Slot = FSnapshotSendTime();
+	}
+}
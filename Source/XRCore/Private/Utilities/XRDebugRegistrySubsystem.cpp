@@ -0,0 +1,18 @@
+#include "Utilities/XRDebugRegistrySubsystem.h"
+
+#include "Engine/World.h"
+
+bool UXRDebugRegistrySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+#if UE_BUILD_SHIPPING
+	return false;
+#else
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+#endif
+}
+
+UXRDebugRegistrySubsystem* UXRDebugRegistrySubsystem::Get(const UObject* InWorldContextObject)
+{
+	const UWorld* World = InWorldContextObject ? InWorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UXRDebugRegistrySubsystem>() : nullptr;
+}
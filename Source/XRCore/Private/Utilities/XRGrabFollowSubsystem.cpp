@@ -0,0 +1,127 @@
+#include "Utilities/XRGrabFollowSubsystem.h"
+#include "Connections/XRConnectorComponent.h"
+#include "Core/XRCoreStats.h"
+#include "Utilities/XRToolsUtilityFunctions.h"
+
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+bool UXRGrabFollowSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UXRGrabFollowSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UXRGrabFollowSubsystem, STATGROUP_Tickables);
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Followers
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+void UXRGrabFollowSubsystem::StartFollowing(AActor* InActor, USceneComponent* InTarget)
+{
+	if (!InActor || !InTarget || !InActor->GetRootComponent())
+	{
+		return;
+	}
+
+	FXRGrabFollower* Follower = FindFollower(InActor);
+	if (!Follower)
+	{
+		Follower = &Followers.AddDefaulted_GetRef();
+		Follower->Actor = InActor;
+
+		// Moving a grabbed prop through the world would otherwise update overlaps of its whole component tree every frame.
+		// Connectors look for sockets with every primitive of their owner, so those actors keep all overlaps.
+		TArray<UPrimitiveComponent*> PrimitiveComponents;
+		if (!InActor->FindComponentByClass<UXRConnectorComponent>())
+		{
+			InActor->GetComponents<UPrimitiveComponent>(PrimitiveComponents);
+		}
+		for (UPrimitiveComponent* PrimitiveComponent : PrimitiveComponents)
+		{
+			// Colliders of XRInteractionComponents stay overlappable, e.g. for the second hand of a two-handed grab
+			if (PrimitiveComponent->GetGenerateOverlapEvents() && UXRToolsUtilityFunctions::GetChildXRInteractions(PrimitiveComponent).Num() == 0)
+			{
+				PrimitiveComponent->SetGenerateOverlapEvents(false);
+				Follower->SuspendedOverlapComponents.Add(PrimitiveComponent);
+			}
+		}
+	}
+
+	Follower->Target = InTarget;
+	Follower->RelativeTransform = InActor->GetActorTransform().GetRelativeTransform(InTarget->GetComponentTransform());
+}
+
+void UXRGrabFollowSubsystem::StopFollowing(AActor* InActor)
+{
+	for (int32 FollowerIndex = 0; FollowerIndex < Followers.Num(); ++FollowerIndex)
+	{
+		if (Followers[FollowerIndex].Actor == InActor)
+		{
+			RestoreOverlaps(Followers[FollowerIndex]);
+			Followers.RemoveAtSwap(FollowerIndex);
+			return;
+		}
+	}
+}
+
+bool UXRGrabFollowSubsystem::IsFollowing(const AActor* InActor) const
+{
+	return Followers.ContainsByPredicate([InActor](const FXRGrabFollower& Follower) { return Follower.Actor == InActor; });
+}
+
+int32 UXRGrabFollowSubsystem::GetNumFollowers() const
+{
+	return Followers.Num();
+}
+
+UXRGrabFollowSubsystem::FXRGrabFollower* UXRGrabFollowSubsystem::FindFollower(const AActor* InActor)
+{
+	return Followers.FindByPredicate([InActor](const FXRGrabFollower& Follower) { return Follower.Actor == InActor; });
+}
+
+void UXRGrabFollowSubsystem::RestoreOverlaps(FXRGrabFollower& InFollower)
+{
+	for (const TWeakObjectPtr<UPrimitiveComponent>& PrimitiveComponent : InFollower.SuspendedOverlapComponents)
+	{
+		if (PrimitiveComponent.IsValid())
+		{
+			PrimitiveComponent->SetGenerateOverlapEvents(true);
+		}
+	}
+	InFollower.SuspendedOverlapComponents.Reset();
+
+	// One overlap update at the release transform instead of one per frame while held
+	if (AActor* Actor = InFollower.Actor.Get())
+	{
+		Actor->UpdateOverlaps();
+	}
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Update
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+void UXRGrabFollowSubsystem::Tick(float DeltaTime)
+{
+	XRCORE_SCOPE_CYCLE_COUNTER(STAT_XRCore_GrabFollow);
+	for (int32 FollowerIndex = Followers.Num() - 1; FollowerIndex >= 0; --FollowerIndex)
+	{
+		FXRGrabFollower& Follower = Followers[FollowerIndex];
+		AActor* Actor = Follower.Actor.Get();
+		USceneComponent* Target = Follower.Target.Get();
+		USceneComponent* RootComponent = Actor ? Actor->GetRootComponent() : nullptr;
+		if (!RootComponent || !Target)
+		{
+			RestoreOverlaps(Follower);
+			Followers.RemoveAtSwap(FollowerIndex);
+			continue;
+		}
+
+		// Not a teleport, so kinematic physics bodies are moved through their kinematic target
+		const FTransform TargetTransform = Follower.RelativeTransform * Target->GetComponentTransform();
+		RootComponent->SetWorldLocationAndRotation(TargetTransform.GetLocation(), TargetTransform.GetRotation(), false, nullptr, ETeleportType::None);
+	}
+}
@@ -0,0 +1,300 @@
+#include "Utilities/XRHandJointCompression.h"
+
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Packet
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+namespace
+{
+	constexpr uint32 AllJointsMask = (1u << XRHandJoints::NumJoints) - 1;
+	constexpr float Sqrt2 = 1.41421356f;
+
+	int32 GetMaxQuantizedValue(int32 InPrecision)
+	{
+		return (1 << (FMath::Clamp(InPrecision, XRHandJoints::MinPrecision, XRHandJoints::MaxPrecision) - 1)) - 1;
+	}
+}
+
+bool FXRHandJointPacket::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	Ar << FrameId;
+	Ar << BaselineFrameId;
+
+	uint32 PrecisionValue = FMath::Clamp<int32>(Precision, XRHandJoints::MinPrecision, XRHandJoints::MaxPrecision);
+	Ar.SerializeInt(PrecisionValue, XRHandJoints::MaxPrecision + 1);
+
+	uint32 JointMask = ChangedJointMask & AllJointsMask;
+	Ar.SerializeBits(&JointMask, XRHandJoints::NumJoints);
+
+	if (Ar.IsLoading())
+	{
+		Precision = static_cast<uint8>(FMath::Clamp<int32>(PrecisionValue, XRHandJoints::MinPrecision, XRHandJoints::MaxPrecision));
+		ChangedJointMask = JointMask & AllJointsMask;
+		ChangedJoints.SetNum(FMath::CountBits(ChangedJointMask));
+	}
+	else if (ChangedJoints.Num() != FMath::CountBits(JointMask))
+	{
+		bOutSuccess = false;
+		return false;
+	}
+
+	const uint32 MaxValue = GetMaxQuantizedValue(Precision);
+	for (FXRQuantizedJointRotation& Joint : ChangedJoints)
+	{
+		uint32 LargestIndex = Joint.LargestIndex;
+		Ar.SerializeInt(LargestIndex, 4);
+		Joint.LargestIndex = static_cast<uint8>(LargestIndex);
+
+		for (int16& Component : Joint.Components)
+		{
+			uint32 Value = static_cast<uint32>(FMath::Clamp<int32>(Component, -static_cast<int32>(MaxValue), MaxValue) + static_cast<int32>(MaxValue));
+			Ar.SerializeInt(Value, 2 * MaxValue + 1);
+			Component = static_cast<int16>(static_cast<int32>(FMath::Min(Value, 2 * MaxValue)) - static_cast<int32>(MaxValue));
+		}
+	}
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
+
+int32 FXRHandJointPacket::GetNumBits() const
+{
+	// FrameId, BaselineFrameId, Precision, ChangedJointMask
+	const int32 HeaderBits = 16 + 16 + 4 + XRHandJoints::NumJoints;
+	const int32 BitsPerJoint = 2 + 3 * FMath::Clamp<int32>(Precision, XRHandJoints::MinPrecision, XRHandJoints::MaxPrecision);
+	return HeaderBits + ChangedJoints.Num() * BitsPerJoint;
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Codec
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+FXRQuantizedJointRotation FXRHandJointCodec::Quantize(const FQuat& InRotation, int32 InPrecision)
+{
+	const FQuat Rotation = InRotation.GetNormalized();
+	const float Components[4] = { static_cast<float>(Rotation.X), static_cast<float>(Rotation.Y), static_cast<float>(Rotation.Z), static_cast<float>(Rotation.W) };
+
+	int32 LargestIndex = 3;
+	for (int32 Index = 0; Index < 3; Index++)
+	{
+		if (FMath::Abs(Components[Index]) > FMath::Abs(Components[LargestIndex]))
+		{
+			LargestIndex = Index;
+		}
+	}
+
+	// q and -q are the same rotation, flip so the dropped component is positive
+	const float Sign = Components[LargestIndex] < 0.0f ? -1.0f : 1.0f;
+
+	// The remaining components are within +-1/sqrt(2)
+	const float Scale = GetMaxQuantizedValue(InPrecision) * Sqrt2;
+
+	FXRQuantizedJointRotation Quantized;
+	Quantized.LargestIndex = static_cast<uint8>(LargestIndex);
+	int32 OutIndex = 0;
+	for (int32 Index = 0; Index < 4; Index++)
+	{
+		if (Index != LargestIndex)
+		{
+			Quantized.Components[OutIndex++] = static_cast<int16>(FMath::RoundToInt(Components[Index] * Sign * Scale));
+		}
+	}
+	return Quantized;
+}
+
+FQuat FXRHandJointCodec::Dequantize(const FXRQuantizedJointRotation& InRotation, int32 InPrecision)
+{
+	const float Scale = 1.0f / (GetMaxQuantizedValue(InPrecision) * Sqrt2);
+	const int32 LargestIndex = FMath::Min<int32>(InRotation.LargestIndex, 3);
+
+	float Components[4];
+	float SumSquared = 0.0f;
+	int32 InIndex = 0;
+	for (int32 Index = 0; Index < 4; Index++)
+	{
+		if (Index != LargestIndex)
+		{
+			Components[Index] = InRotation.Components[InIndex++] * Scale;
+			SumSquared += FMath::Square(Components[Index]);
+		}
+	}
+	Components[LargestIndex] = FMath::Sqrt(FMath::Max(0.0f, 1.0f - SumSquared));
+
+	return FQuat(Components[0], Components[1], Components[2], Components[3]).GetNormalized();
+}
+
+void FXRHandJointCodec::QuantizeFrame(const TArray<FQuat>& InLocalRotations, const TArray<FQuat>& InRestPose, int32 InPrecision, TArray<FXRQuantizedJointRotation>& OutFrame)
+{
+	OutFrame.SetNum(XRHandJoints::NumJoints);
+	for (int32 Joint = 0; Joint < XRHandJoints::NumJoints; Joint++)
+	{
+		const FQuat LocalRotation = InLocalRotations.IsValidIndex(Joint) ? InLocalRotations[Joint] : FQuat::Identity;
+		const FQuat RestRotation = InRestPose.IsValidIndex(Joint) ? InRestPose[Joint] : FQuat::Identity;
+		OutFrame[Joint] = Quantize(RestRotation.Inverse() * LocalRotation, InPrecision);
+	}
+}
+
+void FXRHandJointCodec::DequantizeFrame(const TArray<FXRQuantizedJointRotation>& InFrame, const TArray<FQuat>& InRestPose, int32 InPrecision, TArray<FQuat>& OutLocalRotations)
+{
+	OutLocalRotations.SetNum(XRHandJoints::NumJoints);
+	for (int32 Joint = 0; Joint < XRHandJoints::NumJoints; Joint++)
+	{
+		const FQuat RelativeRotation = InFrame.IsValidIndex(Joint) ? Dequantize(InFrame[Joint], InPrecision) : FQuat::Identity;
+		const FQuat RestRotation = InRestPose.IsValidIndex(Joint) ? InRestPose[Joint] : FQuat::Identity;
+		OutLocalRotations[Joint] = (RestRotation * RelativeRotation).GetNormalized();
+	}
+}
+
+void FXRHandJointCodec::EncodeDelta(const TArray<FXRQuantizedJointRotation>& InFrame, const TArray<FXRQuantizedJointRotation>* InBaseline, FXRHandJointPacket& OutPacket)
+{
+	static const FXRQuantizedJointRotation RestRotation;
+
+	OutPacket.ChangedJointMask = 0;
+	OutPacket.ChangedJoints.Reset();
+	for (int32 Joint = 0; Joint < XRHandJoints::NumJoints && Joint < InFrame.Num(); Joint++)
+	{
+		const FXRQuantizedJointRotation& Baseline = (InBaseline && InBaseline->IsValidIndex(Joint)) ? (*InBaseline)[Joint] : RestRotation;
+		if (InFrame[Joint] != Baseline)
+		{
+			OutPacket.ChangedJointMask |= 1u << Joint;
+			OutPacket.ChangedJoints.Add(InFrame[Joint]);
+		}
+	}
+}
+
+bool FXRHandJointCodec::DecodeDelta(const FXRHandJointPacket& InPacket, const TArray<FXRQuantizedJointRotation>* InBaseline, TArray<FXRQuantizedJointRotation>& OutFrame)
+{
+	if (InPacket.ChangedJoints.Num() != FMath::CountBits(InPacket.ChangedJointMask & AllJointsMask))
+	{
+		return false;
+	}
+
+	if (InBaseline && InBaseline->Num() == XRHandJoints::NumJoints)
+	{
+		OutFrame = *InBaseline;
+	}
+	else
+	{
+		OutFrame.Reset();
+		OutFrame.SetNum(XRHandJoints::NumJoints);
+	}
+
+	int32 ChangedIndex = 0;
+	for (int32 Joint = 0; Joint < XRHandJoints::NumJoints; Joint++)
+	{
+		if (InPacket.ChangedJointMask & (1u << Joint))
+		{
+			OutFrame[Joint] = InPacket.ChangedJoints[ChangedIndex++];
+		}
+	}
+	return true;
+}
+
+float FXRHandJointCodec::GetMaxAngularErrorDegrees(const TArray<FQuat>& InExpected, const TArray<FQuat>& InActual)
+{
+	float MaxError = 0.0f;
+	for (int32 Joint = 0; Joint < InExpected.Num() && Joint < InActual.Num(); Joint++)
+	{
+		MaxError = FMath::Max(MaxError, static_cast<float>(FMath::RadiansToDegrees(InExpected[Joint].AngularDistance(InActual[Joint]))));
+	}
+	return MaxError;
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+// History
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+void FXRHandJointHistory::Add(uint16 InFrameId, const TArray<FXRQuantizedJointRotation>& InFrame)
+{
+	Entries[NextEntry].FrameId = InFrameId;
+	Entries[NextEntry].Frame = InFrame;
+	NextEntry = (NextEntry + 1) % Capacity;
+}
+
+const TArray<FXRQuantizedJointRotation>* FXRHandJointHistory::Find(uint16 InFrameId) const
+{
+	if (InFrameId == 0)
+	{
+		return nullptr;
+	}
+	for (const FEntry& Entry : Entries)
+	{
+		if (Entry.FrameId == InFrameId)
+		{
+			return &Entry.Frame;
+		}
+	}
+	return nullptr;
+}
+
+void FXRHandJointHistory::Reset()
+{
+	for (FEntry& Entry : Entries)
+	{
+		Entry.FrameId = 0;
+		Entry.Frame.Reset();
+	}
+	NextEntry = 0;
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Key frames
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+void FXRHandJointKeyFrameEncoder::Encode(uint16 InFrameId, uint8 InPrecision, const TArray<FXRQuantizedJointRotation>& InFrame, int32 InKeyFrameInterval, FXRHandJointPacket& OutPacket)
+{
+	OutPacket.FrameId = InFrameId;
+	OutPacket.Precision = InPrecision;
+	if (KeyFrameId == 0 || KeyFramePrecision != InPrecision || ++FramesSinceKeyFrame >= InKeyFrameInterval)
+	{
+		KeyFrameId = InFrameId;
+		KeyFramePrecision = InPrecision;
+		KeyFrame = InFrame;
+		FramesSinceKeyFrame = 0;
+		OutPacket.BaselineFrameId = 0;
+		FXRHandJointCodec::EncodeDelta(InFrame, nullptr, OutPacket);
+		return;
+	}
+	OutPacket.BaselineFrameId = KeyFrameId;
+	FXRHandJointCodec::EncodeDelta(InFrame, &KeyFrame, OutPacket);
+}
+
+void FXRHandJointKeyFrameEncoder::Reset()
+{
+	KeyFrameId = 0;
+	KeyFramePrecision = 0;
+	FramesSinceKeyFrame = 0;
+	KeyFrame.Reset();
+}
+
+bool FXRHandJointKeyFrameDecoder::Decode(const FXRHandJointPacket& InPacket, TArray<FXRQuantizedJointRotation>& OutFrame)
+{
+	const bool bKeyFrame = InPacket.BaselineFrameId == 0;
+	// Deltas against a key frame that never arrived wait for the next key frame
+	if (!bKeyFrame && InPacket.BaselineFrameId != KeyFrameId)
+	{
+		return false;
+	}
+
+	TArray<FXRQuantizedJointRotation> Frame;
+	if (!FXRHandJointCodec::DecodeDelta(InPacket, bKeyFrame ? nullptr : &KeyFrame, Frame))
+	{
+		return false;
+	}
+	// A late key frame is still the baseline of the deltas that follow it
+	if (bKeyFrame && (KeyFrameId == 0 || XRHandJoints::IsNewerFrame(InPacket.FrameId, KeyFrameId)))
+	{
+		KeyFrameId = InPacket.FrameId;
+		KeyFrame = Frame;
+	}
+	if (LastAppliedFrameId != 0 && !XRHandJoints::IsNewerFrame(InPacket.FrameId, LastAppliedFrameId))
+	{
+		return false;
+	}
+	LastAppliedFrameId = InPacket.FrameId;
+	OutFrame = MoveTemp(Frame);
+	return true;
+}
+
+void FXRHandJointKeyFrameDecoder::Reset()
+{
+	KeyFrameId = 0;
+	LastAppliedFrameId = 0;
+	KeyFrame.Reset();
+}
@@ -1,4 +1,6 @@
 #include "Utilities/XRHighlightComponent.h"
+#include "Core/XRCoreStats.h"
+#include "Utilities/XRDebugRegistrySubsystem.h"
 
 UXRHighlightComponent::UXRHighlightComponent()
 {
@@ -10,14 +12,22 @@ UXRHighlightComponent::UXRHighlightComponent()
 void UXRHighlightComponent::BeginPlay()
 {
 	Super::BeginPlay();
+	UXRDebugRegistrySubsystem::Register<UXRHighlightComponent>(this);
 	InitializeFadeTimeline();
 	SetHighlightIncludeOnlyTags(HighlightIncludeOnlyTags);
 	SetHighlightFadeCurve(HighlightFadeCurve);
 }
 
+void UXRHighlightComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UXRDebugRegistrySubsystem::Unregister<UXRHighlightComponent>(this);
+	Super::EndPlay(EndPlayReason);
+}
+
 void UXRHighlightComponent::TickComponent(float DeltaTime, ELevelTick TickType,
 	FActorComponentTickFunction* ThisTickFunction)
 {
+	XRCORE_SCOPE_CYCLE_COUNTER(STAT_XRCore_Highlights);
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 	FadeTimeline.TickTimeline(DeltaTime);
 }
@@ -26,6 +36,7 @@ void UXRHighlightComponent::TickComponent(float DeltaTime, ELevelTick TickType,
 
 void UXRHighlightComponent::SetHighlighted(float InHighlightState)
 {
+	XRCORE_SCOPE_CYCLE_COUNTER(STAT_XRCore_Highlights);
 	HighlightState = InHighlightState;
 
 	if (FadeTimeline.IsPlaying() && InHighlightState == 0.0f)
@@ -44,6 +55,7 @@ void UXRHighlightComponent::SetHighlighted(float InHighlightState)
 
 void UXRHighlightComponent::FadeXRHighlight(bool bFadeIn)
 {
+	XRCORE_SCOPE_CYCLE_COUNTER(STAT_XRCore_Highlights);
 	if (!IsActive())
 	{
 		SetHighlighted(0.0f);
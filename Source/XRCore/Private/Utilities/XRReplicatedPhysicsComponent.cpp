@@ -1,13 +1,71 @@
 #include "Utilities/XRReplicatedPhysicsComponent.h"
+#include "Core/XRCoreStats.h"
 #include "Core/XRCoreSettings.h"
+#include "Utilities/XRCoreNetStats.h"
+#include "Utilities/XRDebugRegistrySubsystem.h"
 
 #include "TimerManager.h"
 #include "Components/MeshComponent.h"
 #include "Components/StaticMeshComponent.h"
+#include "Engine/NetDriver.h"
+#include "Engine/NetSerialization.h"
+#include "Engine/PackageMapClient.h"
 #include "Engine/World.h"
 #include "GameFramework/Actor.h"
 #include "Net/UnrealNetwork.h"
 
+#if XRCORE_WITH_NET_STATS
+namespace XRReplicatedPhysics
+{
+	// Net GUIDs match on server and clients, so snapshots can be traced across the worlds of one process
+	uint32 GetNetStatsKey(const AActor* InActor)
+	{
+		const UNetDriver* NetDriver = InActor ? InActor->GetNetDriver() : nullptr;
+		if (!NetDriver || !NetDriver->GuidCache.IsValid())
+		{
+			return 0;
+		}
+		return NetDriver->GuidCache->GetNetGUID(InActor).Value;
+	}
+}
+#endif
+
+// -----------------------------------------------------------------------------------------------------------------------------------
+// Snapshot
+// -----------------------------------------------------------------------------------------------------------------------------------
+bool FXRPhysicsSnapshot::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	Ar << ID;
+
+	// 1 bit interacted with, 2 bit precision
+	uint8 Flags = Ar.IsSaving() ? ((bIsInteractedWith != 0 ? 1 : 0) | (static_cast<uint8>(Precision) << 1)) : 0;
+	Ar.SerializeBits(&Flags, 3);
+	bIsInteractedWith = Flags & 1;
+	Precision = static_cast<EXRReplicationPrecision>((Flags >> 1) & 3);
+
+	bOutSuccess = true;
+	switch (Precision)
+	{
+	case EXRReplicationPrecision::Full:
+		Ar << Location;
+		Ar << Rotation;
+		break;
+	case EXRReplicationPrecision::High:
+		bOutSuccess &= SerializePackedVector<100, 30>(Location, Ar);
+		Rotation.SerializeCompressedShort(Ar);
+		break;
+	case EXRReplicationPrecision::Medium:
+		bOutSuccess &= SerializePackedVector<10, 24>(Location, Ar);
+		Rotation.SerializeCompressedShort(Ar);
+		break;
+	case EXRReplicationPrecision::Low:
+		bOutSuccess &= SerializePackedVector<1, 20>(Location, Ar);
+		Rotation.SerializeCompressed(Ar);
+		break;
+	}
+	return true;
+}
+
 UXRReplicatedPhysicsComponent::UXRReplicatedPhysicsComponent()
 {
 	PrimaryComponentTick.bCanEverTick = true;
@@ -19,30 +77,33 @@ UXRReplicatedPhysicsComponent::UXRReplicatedPhysicsComponent()
 void UXRReplicatedPhysicsComponent::BeginPlay()
 {
 	Super::BeginPlay();
+	UXRDebugRegistrySubsystem::Register<UXRReplicatedPhysicsComponent>(this);
 
-	DefaultReplicationInterval = GetDefault<UXRCoreSettings>()->DefaultReplicationInterval;
-	InteractedReplicationInterval = GetDefault<UXRCoreSettings>()->InteractedReplicationInterval;
+	ActiveProfile = GetDefault<UXRCoreSettings>()->GetReplicationProfile(ReplicationProfile);
 
 	RegisterPhysicsMeshComponents(RegisterMeshComponentsWithTag);
 	if (GetOwnerRole() == ROLE_Authority )
 	{
-		FXRPhysicsSnapshot NewSnapshot;
-		NewSnapshot.ID = 1;
-		NewSnapshot.Location = GetOwner()->GetActorLocation();
-		NewSnapshot.Rotation = GetOwner()->GetActorRotation();
-		NewSnapshot.bIsInteractedWith = false;
-
-		Server_SetReplicatedSnapshot(NewSnapshot);
-		SetSimulatePhysicsOnOwner(true);
+		Server_SetReplicatedSnapshot(MakeSnapshot(false));
+		if (bSimulatePhysics)
+		{
+			SetSimulatePhysicsOnOwner(true);
+		}
 	}
 	
     FTimerHandle TimerHandle;
     GetWorld()->GetTimerManager().SetTimer(TimerHandle, this, &UXRReplicatedPhysicsComponent::DelayedPhysicsSetup, 0.5f, false);
 }
 
+void UXRReplicatedPhysicsComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UXRDebugRegistrySubsystem::Unregister<UXRReplicatedPhysicsComponent>(this);
+	Super::EndPlay(EndPlayReason);
+}
+
 void UXRReplicatedPhysicsComponent::DelayedPhysicsSetup()
 {
-	if (bAutoActivate)
+	if (bAutoActivate && bSimulatePhysics)
 	{
 		SetSimulatePhysicsOnOwner(GetOwnerRole() == ROLE_Authority);
 	}
@@ -78,8 +139,19 @@ void UXRReplicatedPhysicsComponent::OnRep_ReplicatedSnapshot()
 {
 	if (GetOwnerRole() != ROLE_Authority)
 	{
+		RecordSnapshotTiming();
 		ClientActiveSnapshot = ReplicatedSnapshot;
+		if (!ShouldApplySnapshot(ReplicatedSnapshot))
+		{
+			return;
+		}
 		GetOwner()->SetActorLocationAndRotation(ReplicatedSnapshot.Location, ReplicatedSnapshot.Rotation);
+#if XRCORE_WITH_NET_STATS
+		if (FXRCoreNetStats::IsTrackingEnabled())
+		{
+			FXRCoreNetStats::RecordSnapshotShown(XRReplicatedPhysics::GetNetStatsKey(GetOwner()), ReplicatedSnapshot.ID);
+		}
+#endif
 	}
 }
 
@@ -88,23 +160,87 @@ FXRPhysicsSnapshot UXRReplicatedPhysicsComponent::GetLatestSnapshot() const
 	return ReplicatedSnapshot;
 }
 
+void UXRReplicatedPhysicsComponent::SetDrivenLocally(bool bInDrivenLocally)
+{
+	bDrivenLocally = bInDrivenLocally;
+}
+
+bool UXRReplicatedPhysicsComponent::IsDrivenLocally() const
+{
+	return bDrivenLocally;
+}
+
+// A locally driven owner already shows the held transform, applying the server snapshots would pull it back by the network delay
+bool UXRReplicatedPhysicsComponent::ShouldApplySnapshot(const FXRPhysicsSnapshot& InSnapshot) const
+{
+	return !bDrivenLocally || InSnapshot.bIsInteractedWith == 0;
+}
+
+void UXRReplicatedPhysicsComponent::SetReplicationProfile(FName InReplicationProfile)
+{
+	if (GetOwnerRole() == ROLE_Authority)
+	{
+		WakeNetDormancy();
+	}
+	ReplicationProfile = InReplicationProfile;
+	ActiveProfile = GetDefault<UXRCoreSettings>()->GetReplicationProfile(ReplicationProfile);
+}
+
+void UXRReplicatedPhysicsComponent::OnRep_ReplicationProfile()
+{
+	ActiveProfile = GetDefault<UXRCoreSettings>()->GetReplicationProfile(ReplicationProfile);
+}
+
+TArray<FName> UXRReplicatedPhysicsComponent::GetReplicationProfileNames() const
+{
+	TArray<FName> ProfileNames = { NAME_None };
+	for (const TPair<FName, FXRReplicationProfile>& Pair : GetDefault<UXRCoreSettings>()->ReplicationProfiles)
+	{
+		ProfileNames.Add(Pair.Key);
+	}
+	return ProfileNames;
+}
+
 // -----------------------------------------------------------------------------------------------------------------------------------
 // Serverside 
 // -----------------------------------------------------------------------------------------------------------------------------------
 void UXRReplicatedPhysicsComponent::Server_ForceUpdate_Implementation()
+{
+	WakeNetDormancy();
+	Server_SetReplicatedSnapshot(MakeSnapshot(bIsInteractedWith));
+}
+
+FXRPhysicsSnapshot UXRReplicatedPhysicsComponent::MakeSnapshot(bool bInInteractedWith) const
 {
 	FXRPhysicsSnapshot NewSnapshot;
 	NewSnapshot.ID = ReplicatedSnapshot.ID + 1;
 	NewSnapshot.Location = GetOwner()->GetActorLocation();
 	NewSnapshot.Rotation = GetOwner()->GetActorRotation();
-	NewSnapshot.bIsInteractedWith = bIsInteractedWith;
+	NewSnapshot.bIsInteractedWith = bInInteractedWith;
+	NewSnapshot.Precision = ActiveProfile.Precision;
+	return NewSnapshot;
+}
 
-	Server_SetReplicatedSnapshot(NewSnapshot);
+// Clients hold the last snapshot until the next one arrives, so it is their prediction of the current transform
+bool UXRReplicatedPhysicsComponent::IsWithinDeadReckoningThreshold() const
+{
+	if (ActiveProfile.DeadReckoningThreshold <= 0.0f && ActiveProfile.DeadReckoningAngleThreshold <= 0.0f)
+	{
+		return false;
+	}
+	const AActor* Owner = GetOwner();
+	if (FVector::DistSquared(Owner->GetActorLocation(), ReplicatedSnapshot.Location) > FMath::Square(ActiveProfile.DeadReckoningThreshold))
+	{
+		return false;
+	}
+	const float AngleDegrees = FMath::RadiansToDegrees(Owner->GetActorQuat().AngularDistance(ReplicatedSnapshot.Rotation.Quaternion()));
+	return AngleDegrees <= ActiveProfile.DeadReckoningAngleThreshold;
 }
 
 
 void UXRReplicatedPhysicsComponent::ServerTick(float DeltaTime)
 {
+	XRCORE_SCOPE_CYCLE_COUNTER(STAT_XRCore_PhysicsServerTick);
 	if (!bPhysicsActive)
 	{
 		return;
@@ -116,29 +252,30 @@ void UXRReplicatedPhysicsComponent::ServerTick(float DeltaTime)
 		// Replicate only one time, when the object becomes static
 		if (ReplicatedSnapshot.Location != GetOwner()->GetActorLocation())
 		{
-			FXRPhysicsSnapshot NewSnapshot;
-			NewSnapshot.ID = ReplicatedSnapshot.ID + 1;
-			NewSnapshot.Location = GetOwner()->GetActorLocation();
-			NewSnapshot.Rotation = GetOwner()->GetActorRotation();
-			NewSnapshot.bIsInteractedWith = false;
-
-			Server_SetReplicatedSnapshot(NewSnapshot);
+			WakeNetDormancy();
+			Server_SetReplicatedSnapshot(MakeSnapshot(false));
+		}
+		// The rest snapshot is still sent, the net driver only closes the channel once all properties are acknowledged
+		else if (bEnableNetDormancy && !IsNetDormant())
+		{
+			RestTime += DeltaTime;
+			if (RestTime >= ActiveProfile.DormancyTimeout)
+			{
+				GetOwner()->SetNetDormancy(DORM_DormantAll);
+			}
 		}
 		return;
 	}
 
-	float ReplicationInterval = ReplicatedSnapshot.bIsInteractedWith != 0 ? InteractedReplicationInterval : DefaultReplicationInterval;
+	// Moving (e.g. after a collision impulse) or interacted with
+	WakeNetDormancy();
+
+	float ReplicationInterval = ReplicatedSnapshot.bIsInteractedWith != 0 ? ActiveProfile.InteractedReplicationInterval : ActiveProfile.ReplicationInterval;
 	AccumulatedTime += DeltaTime;
-	if (AccumulatedTime >= ReplicationInterval)
+	// Within the threshold the interval stays elapsed, so the snapshot goes out as soon as the owner leaves it
+	if (AccumulatedTime >= ReplicationInterval && !IsWithinDeadReckoningThreshold())
 	{
-		FXRPhysicsSnapshot NewSnapshot;
-		NewSnapshot.ID = ReplicatedSnapshot.ID + 1;
-		NewSnapshot.Location = GetOwner()->GetActorLocation();
-		NewSnapshot.Rotation = GetOwner()->GetActorRotation();
-		NewSnapshot.bIsInteractedWith = bIsInteractedWith;
-
-		Server_SetReplicatedSnapshot(NewSnapshot);
-
+		Server_SetReplicatedSnapshot(MakeSnapshot(bIsInteractedWith));
 		AccumulatedTime = 0.0f;
 	}
 }
@@ -146,6 +283,63 @@ void UXRReplicatedPhysicsComponent::ServerTick(float DeltaTime)
 void UXRReplicatedPhysicsComponent::Server_SetReplicatedSnapshot_Implementation(FXRPhysicsSnapshot InReplicatedSnapshot)
 {
 	ReplicatedSnapshot = InReplicatedSnapshot;
+	RecordSnapshotTiming();
+	XRCORE_RECORD_NET_MESSAGE(EXRNetFeature::PhysicsSnapshot, FXRCoreNetStats::GetNetSerializedBytes(ReplicatedSnapshot), FXRCoreNetStats::GetNumClientReceivers(GetOwner()));
+#if XRCORE_WITH_NET_STATS
+	if (FXRCoreNetStats::IsTrackingEnabled())
+	{
+		FXRCoreNetStats::RecordSnapshotSent(XRReplicatedPhysics::GetNetStatsKey(GetOwner()), ReplicatedSnapshot.ID);
+	}
+#endif
+}
+
+void UXRReplicatedPhysicsComponent::WakeNetDormancy()
+{
+	RestTime = 0.0f;
+	AActor* Owner = GetOwner();
+	if (Owner && Owner->HasAuthority() && Owner->NetDormancy > DORM_Awake)
+	{
+		Owner->SetNetDormancy(DORM_Awake);
+	}
+}
+
+float UXRReplicatedPhysicsComponent::GetSnapshotRate() const
+{
+	const UWorld* World = GetWorld();
+	if (!World || LastSnapshotTime <= 0.0 || AverageSnapshotInterval <= 0.0f)
+	{
+		return 0.0f;
+	}
+	// Decays while no snapshots arrive
+	const float Interval = FMath::Max(AverageSnapshotInterval, static_cast<float>(World->GetTimeSeconds() - LastSnapshotTime));
+	return 1.0f / FMath::Max(Interval, KINDA_SMALL_NUMBER);
+}
+
+float UXRReplicatedPhysicsComponent::GetInterpolationError() const
+{
+	return InterpolationError;
+}
+
+void UXRReplicatedPhysicsComponent::RecordSnapshotTiming()
+{
+	const UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+	const double Now = World->GetTimeSeconds();
+	if (LastSnapshotTime > 0.0)
+	{
+		const float Interval = static_cast<float>(Now - LastSnapshotTime);
+		AverageSnapshotInterval = AverageSnapshotInterval > 0.0f ? FMath::Lerp(AverageSnapshotInterval, Interval, 0.1f) : Interval;
+	}
+	LastSnapshotTime = Now;
+}
+
+bool UXRReplicatedPhysicsComponent::IsNetDormant() const
+{
+	const AActor* Owner = GetOwner();
+	return Owner && Owner->NetDormancy > DORM_Awake;
 }
 
 void UXRReplicatedPhysicsComponent::SetInteractedWith(bool bInInteracedWith)
@@ -164,6 +358,7 @@ bool UXRReplicatedPhysicsComponent::GetInteractedWith() const
 // -----------------------------------------------------------------------------------------------------------------------------------
 void UXRReplicatedPhysicsComponent::ClientTick(float DeltaTime)
 {
+	XRCORE_SCOPE_CYCLE_COUNTER(STAT_XRCore_PhysicsClientTick);
 	if (!bPhysicsActive)
 	{
 		return;
@@ -174,13 +369,20 @@ void UXRReplicatedPhysicsComponent::ClientTick(float DeltaTime)
 		ClientActiveSnapshot = ReplicatedSnapshot;
 	}
 
+	if (!ShouldApplySnapshot(ClientActiveSnapshot))
+	{
+		return;
+	}
+
 	if (bDebugDisableClientInterpolation)
 	{
 		GetOwner()->SetActorLocationAndRotation(ReplicatedSnapshot.Location, ReplicatedSnapshot.Rotation);
+		InterpolationError = 0.0f;
 		return;
 	}
-	float ReplicationInterval = ReplicatedSnapshot.bIsInteractedWith != 0 ? InteractedReplicationInterval : DefaultReplicationInterval;
-	float SafeInterval = FMath::Max(ReplicationInterval * 2.0f, KINDA_SMALL_NUMBER);
+	float ReplicationInterval = ReplicatedSnapshot.bIsInteractedWith != 0 ? ActiveProfile.InteractedReplicationInterval : ActiveProfile.ReplicationInterval;
+	float InterpolationDelay = ActiveProfile.InterpolationDelay > 0.0f ? ActiveProfile.InterpolationDelay : ReplicationInterval * 2.0f;
+	float SafeInterval = FMath::Max(InterpolationDelay, KINDA_SMALL_NUMBER);
 	float InterpSpeed = 1.0f / SafeInterval;
 
 
@@ -191,6 +393,7 @@ void UXRReplicatedPhysicsComponent::ClientTick(float DeltaTime)
 	FRotator InterpRotation = FMath::RInterpTo(GetOwner()->GetActorRotation(), TargetRotation, DeltaTime, InterpSpeed);
 
 	GetOwner()->SetActorLocationAndRotation(InterpLocation, InterpRotation);
+	InterpolationError = FVector::Dist(InterpLocation, TargetLocation);
 }
 
 void UXRReplicatedPhysicsComponent::OnRep_PhysicsActive()
@@ -218,6 +421,11 @@ bool UXRReplicatedPhysicsComponent::IsSequenceIDNewer(uint32 InID1, uint32 InID2
 
 void UXRReplicatedPhysicsComponent::SetSimulatePhysicsOnOwner(bool InSimulatePhysics)
 {
+	// bPhysicsActive is replicated
+	if (bPhysicsActive != InSimulatePhysics && GetOwnerRole() == ROLE_Authority)
+	{
+		WakeNetDormancy();
+	}
 	for (auto* PhysicsMeshComponent : GetRegisteredMeshComponents())
 	{
 		PhysicsMeshComponent->SetSimulatePhysics(InSimulatePhysics);
@@ -291,5 +499,6 @@ void UXRReplicatedPhysicsComponent::GetLifetimeReplicatedProps(TArray<FLifetimeP
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 	DOREPLIFETIME(UXRReplicatedPhysicsComponent, ReplicatedSnapshot); 
 	DOREPLIFETIME(UXRReplicatedPhysicsComponent, bPhysicsActive);
+	DOREPLIFETIME(UXRReplicatedPhysicsComponent, ReplicationProfile);
 
 }
@@ -1,4 +1,5 @@
 #include "Utilities/XRToolsUtilityFunctions.h"
+#include "Core/XRCoreStats.h"
 #include "Interactions/XRInteractionComponent.h"
 #include "Interactions/XRInteractorComponent.h"
 #include "Connections/XRConnectorComponent.h"
@@ -46,12 +47,10 @@ bool UXRToolsUtilityFunctions::IsActorInteractedWith(AActor* InActor, TArray<UXR
     }
 
     OutActiveXRInteractions.Empty();
-    TArray<UActorComponent*> Components;
-    InActor->GetComponents(Components);
+    TInlineComponentArray<UXRInteractionComponent*> InteractionComponents(InActor);
 
-    for (UActorComponent* Component : Components)
+    for (UXRInteractionComponent* InteractionComponent : InteractionComponents)
     {
-        UXRInteractionComponent* InteractionComponent = Cast<UXRInteractionComponent>(Component);
         if (InteractionComponent && InteractionComponent->IsInteractedWith())
         {
             OutActiveXRInteractions.Add(InteractionComponent);
@@ -65,6 +64,7 @@ bool UXRToolsUtilityFunctions::IsActorInteractedWith(AActor* InActor, TArray<UXR
 UXRInteractionComponent* UXRToolsUtilityFunctions::GetXRInteractionByPriority(const TArray<UXRInteractionComponent*>& InInteractions, UXRInteractorComponent* InXRInteractor, int32 InPriority, 
     EXRInteractionPrioritySelection InPrioritySelectionCondition, int32 MaxSecondaryPriority)
 {
+    XRCORE_SCOPE_CYCLE_COUNTER(STAT_XRCore_PriorityResolution);
     if (InInteractions.Num() == 0)
     {
         return nullptr;
@@ -94,7 +94,7 @@ UXRInteractionComponent* UXRToolsUtilityFunctions::GetXRInteractionByPriority(co
             if (InXRInteractor)
             {
                 // This Interactor is already Interacting with this Interaction
-                if (XRInteraction->GetActiveInteractors().Contains(InXRInteractor))
+                if (XRInteraction->IsInteractedWithBy(InXRInteractor))
                 {
                     continue;
                 }
@@ -157,6 +157,27 @@ UXRInteractionComponent* UXRToolsUtilityFunctions::GetXRInteractionOnActorByPrio
     return GetXRInteractionByPriority(InteractionComponents, InXRInteractor, InPriority, InPrioritySelectionCondition);
 }
 
+TArray<UXRInteractionComponent*> UXRToolsUtilityFunctions::GetChildXRInteractions(USceneComponent* InComponent)
+{
+    TArray<UXRInteractionComponent*> FoundXRInteractions = {};
+    if (!InComponent)
+    {
+        return FoundXRInteractions;
+    }
+
+    TArray<USceneComponent*> ChildComponents;
+    InComponent->GetChildrenComponents(true, ChildComponents);
+    for (USceneComponent* ChildComponent : ChildComponents)
+    {
+        UXRInteractionComponent* FoundXRInteraction = Cast<UXRInteractionComponent>(ChildComponent);
+        if (FoundXRInteraction)
+        {
+            FoundXRInteractions.Add(FoundXRInteraction);
+        }
+    }
+    return FoundXRInteractions;
+}
+
 void UXRToolsUtilityFunctions::TryConnectToActor(UXRConnectorComponent* InConnector, AActor* InActor, const FString& InSocketID)
 {
     if (!InActor || !InConnector)
@@ -94,6 +94,12 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "XRConnector")
 	void SetHologramState(UXRConnectorSocket* InSocket, EXRHologramState InState);
 
+	/*
+	* Number of Holograms of this connector currently shown.
+	*/
+	UFUNCTION(BlueprintPure, Category = "XRConnector")
+	int32 GetNumVisibleHolograms() const;
+
 
 protected:
 	virtual void BeginPlay() override; 
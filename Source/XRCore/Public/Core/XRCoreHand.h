@@ -13,6 +13,7 @@
 
 class UXRInteractorComponent;
 class UXRLaserComponent;
+class UActorChannel;
 
 // ================================================================================================================================================================
 // Replicated Hand Actor, attached to the MotionController and used for InteractionSystem and Input
@@ -29,6 +30,34 @@ public:
     UFUNCTION(BlueprintPure, Category = "XRCore|XRCoreHand")
     FXRCoreHandReplicationData GetReplicatedHandData() const;
 
+    /**
+     * Server only: store the latest hand data to replicate it to all connections but the owner (EXRHandReplicationMode::ReplicatedProperty).
+     */
+    void SetServerHandData(const FXRCoreHandReplicationData& InXRCoreHandData);
+
+    /**
+     * Remote: local rotations of the 26 hand-tracking joints (EHandKeypoint order) last received for this hand. Empty until joint data arrived.
+     */
+    UFUNCTION(BlueprintPure, Category = "XRCore|XRCoreHand")
+    TArray<FQuat> GetReplicatedHandJoints() const;
+
+    void GetHandJointRestPose(TArray<FQuat>& OutRestPose) const;
+
+    /**
+     * Remote: reconstruct the joint rotations from a key frame or a delta against the last key frame. Stale frames and deltas against a lost key frame are ignored.
+     */
+    void ApplyHandJointPacket(const FXRHandJointPacket& InPacket);
+
+    /**
+     * Server only: store the latest joint frame to replicate it to all connections but the owner (EXRHandReplicationMode::ReplicatedProperty).
+     */
+    void SetServerHandJoints(const FXRHandJointPacket& InPacket);
+
+    virtual bool IsNetRelevantFor(const AActor* RealViewer, const AActor* ViewTarget, const FVector& SrcLocation) const override;
+    virtual float GetNetPriority(const FVector& ViewPos, const FVector& ViewDir, AActor* Viewer, AActor* ViewTarget, UActorChannel* InChannel, float Time, bool bLowBandwidth) override;
+    // HandNetCullDistance in ReplicatedProperty mode, the engine NetCullDistance otherwise
+    float GetHandNetCullDistance() const;
+
     // ------------------------------------------------------------------------------------------------------------------------------------------------------------
     // API
     // ------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -72,14 +101,73 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "XRCore|XRCoreHand")
     bool bIsLocallyControlled = false;
 
+    /**
+     * Server: replication mode of the spawning XRCoreHandComponent. HandNetCullDistance only applies to ReplicatedProperty hands.
+     */
+    UPROPERTY()
+    EXRHandReplicationMode HandReplicationMode = EXRHandReplicationMode::Multicast;
+
 protected:
     virtual void BeginPlay() override;
 
     UPROPERTY()
     FXRCoreHandReplicationData ReplicatedHandData;
 
-    UPROPERTY(EditDefaultsOnly, Category = "XRCore|XRCoreHand", meta = (ClampMin = "0.0"))
-    float InterpolationSpeed = 10.f;
+    // Latest hand data on the server, replicated to everyone but the owner
+    UPROPERTY(ReplicatedUsing = OnRep_ServerHandData)
+    FXRCoreHandReplicationData ServerHandData;
+    UFUNCTION()
+    void OnRep_ServerHandData();
+
+    /**
+     * ReplicatedProperty mode: hands further away from a viewer than this (cm) are not replicated to it. Never exceeds the relevancy of the owning pawn.
+     */
+    UPROPERTY(EditDefaultsOnly, Category = "XRCore|XRCoreHand|Replication", meta = (ClampMin = "0.0"))
+    float HandNetCullDistance = 5000.0f;
+
+    /**
+     * Net priority scale for a hand at HandNetCullDistance, nearer hands scale linearly up to 1.
+     */
+    UPROPERTY(EditDefaultsOnly, Category = "XRCore|XRCoreHand|Replication", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+    float DistantNetPriorityScale = 0.2f;
+
+    /**
+     * Local rotation of each hand-tracking joint in the rest pose (EHandKeypoint order). Joint data is quantized relative to it, empty uses identity.
+     */
+    UPROPERTY(EditDefaultsOnly, Category = "XRCore|XRCoreHand|Replication")
+    TArray<FRotator> HandJointRestPose;
+
+    UPROPERTY(ReplicatedUsing = OnRep_ServerHandJoints)
+    FXRHandJointPacket ServerHandJoints;
+    UFUNCTION()
+    void OnRep_ServerHandJoints();
+
+    // ------------------------------------------------------------------------------------------------------------------------------------------------------------
+    // Remote playback - received hand data is buffered and played back with a delay that adapts to the send interval and jitter
+    // ------------------------------------------------------------------------------------------------------------------------------------------------------------
+    UPROPERTY(EditDefaultsOnly, Category = "XRCore|XRCoreHand|Replication", meta = (ClampMin = "0.0"))
+    float MinInterpolationDelay = 0.02f;
+
+    UPROPERTY(EditDefaultsOnly, Category = "XRCore|XRCoreHand|Replication", meta = (ClampMin = "0.0"))
+    float MaxInterpolationDelay = 0.3f;
+
+    /**
+     * Multiple of the measured network jitter added to the playback delay. Higher values trade latency for less extrapolation.
+     */
+    UPROPERTY(EditDefaultsOnly, Category = "XRCore|XRCoreHand|Replication", meta = (ClampMin = "0.0"))
+    float JitterDelayMultiplier = 2.0f;
+
+    /**
+     * Maximum time in seconds a remote hand continues along its last velocity when no new data arrived in time.
+     */
+    UPROPERTY(EditDefaultsOnly, Category = "XRCore|XRCoreHand|Replication", meta = (ClampMin = "0.0"))
+    float MaxExtrapolationTime = 0.1f;
+
+    /**
+     * Current playback delay of this remote hand in seconds.
+     */
+    UFUNCTION(BlueprintPure, Category = "XRCore|XRCoreHand")
+    float GetInterpolationDelay() const;
 
     UPROPERTY(BlueprintReadWrite, Category = "XRCore|XRCoreHand")
     bool bIsHandtrackingActive = false;
@@ -89,4 +177,22 @@ protected:
 
     UPROPERTY(BlueprintReadWrite, Category = "XRCore|XRCoreHand")
     float LocallyControlled_SecondaryInputAxisValue = 0.0f;
+
+private:
+    void AddHandSample(const FXRCoreHandReplicationData& InSample);
+    bool SampleHandPose(double InPlaybackTime, FVector& OutLocation, FQuat& OutRotation) const;
+
+    static constexpr int32 MaxBufferedHandSamples = 8;
+
+    // Received samples, ordered by sender timestamp
+    TArray<FXRCoreHandReplicationData> HandSampleBuffer;
+
+    // Smoothed difference between local and sender clock, including the network delay
+    double ClockOffset = 0.0;
+    double LastPlaybackTime = 0.0;
+    float AverageSendInterval = 0.1f;
+    float Jitter = 0.0f;
+
+    TArray<FQuat> ReplicatedHandJoints;
+    FXRHandJointKeyFrameDecoder JointDecoder;
 };
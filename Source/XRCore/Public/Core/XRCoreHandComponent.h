@@ -3,8 +3,10 @@
 #include "CoreMinimal.h"
 #include "Components/SceneComponent.h"
 #include "InputCoreTypes.h"
+#include "TimerManager.h"
 
 #include "Core/XRCoreTypes.h"
+#include "Utilities/XRHandJointCompression.h"
 #include "XRCoreHandComponent.generated.h"
 
 class AXRCoreHand;
@@ -50,10 +52,91 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category = "XRCore|XRCoreHand", meta = (ClampMin = "0.0"))
 	float ReplicationInterval = 0.1f;
 
+	/*
+	* Send hand data depending on motion instead of every ReplicationInterval.
+	* Fast motion sends up to every MinReplicationInterval, a still hand only every HeartbeatInterval and input axis changes are sent immediately.
+	*/
+	UPROPERTY(EditDefaultsOnly, Category = "XRCore|XRCoreHand|Adaptive Rate")
+	bool bAdaptiveReplicationRate = false;
+
+	UPROPERTY(EditDefaultsOnly, Category = "XRCore|XRCoreHand|Adaptive Rate", meta = (ClampMin = "0.0", EditCondition = "bAdaptiveReplicationRate"))
+	float MinReplicationInterval = 0.033f;
+
+	UPROPERTY(EditDefaultsOnly, Category = "XRCore|XRCoreHand|Adaptive Rate", meta = (ClampMin = "0.0", EditCondition = "bAdaptiveReplicationRate"))
+	float HeartbeatInterval = 0.5f;
+
+	/*
+	* Send once the hand moved this far (cm) from the last sent location.
+	*/
+	UPROPERTY(EditDefaultsOnly, Category = "XRCore|XRCoreHand|Adaptive Rate", meta = (ClampMin = "0.0", EditCondition = "bAdaptiveReplicationRate"))
+	float LocationSendThreshold = 0.5f;
+
+	/*
+	* Send once the hand rotated this far (degrees) from the last sent rotation.
+	*/
+	UPROPERTY(EditDefaultsOnly, Category = "XRCore|XRCoreHand|Adaptive Rate", meta = (ClampMin = "0.0", EditCondition = "bAdaptiveReplicationRate"))
+	float RotationSendThreshold = 2.0f;
+
+	/*
+	* Input axis change since the last send that is sent immediately.
+	*/
+	UPROPERTY(EditDefaultsOnly, Category = "XRCore|XRCoreHand|Adaptive Rate", meta = (ClampMin = "0.0", EditCondition = "bAdaptiveReplicationRate"))
+	float InputAxisSendThreshold = 0.05f;
+
+	/*
+	* Locally controlled only: send rate and error of the last sent versus the tracked pose, in either rate mode.
+	*/
+	UFUNCTION(BlueprintPure, Category = "XRCore|XRCoreHand")
+	FXRHandReplicationMetrics GetReplicationMetrics() const;
+
+	UFUNCTION(BlueprintCallable, Category = "XRCore|XRCoreHand")
+	void ResetReplicationMetrics();
+
+	/*
+	* How the server forwards hand data to other clients.
+	* Multicast: every update is sent to all clients, including the sender.
+	* ReplicatedProperty: the XRCoreHand replicates the latest update to everyone but the owner, distant hands are updated less often.
+	*/
+	UPROPERTY(EditDefaultsOnly, Category = "XRCore|XRCoreHand")
+	EXRHandReplicationMode HandReplicationMode = EXRHandReplicationMode::Multicast;
+
+	/*
+	* Replicate the hand-tracking joint rotations provided via SetHandJointRotations while hand tracking is active.
+	* Remote XRCoreHands expose them via GetReplicatedHandJoints.
+	*/
+	UPROPERTY(EditDefaultsOnly, Category = "XRCore|XRCoreHand|HandTracking")
+	bool bReplicateHandJoints = false;
+
+	/*
+	* Interval at which the locally controlled hand sends joint frames.
+	*/
+	UPROPERTY(EditDefaultsOnly, Category = "XRCore|XRCoreHand|HandTracking", meta = (ClampMin = "0.01", EditCondition = "bReplicateHandJoints"))
+	float JointReplicationInterval = 0.05f;
+
+	/*
+	* Bits per quantized joint rotation component. 10 bits keep the reconstruction error well below one degree.
+	*/
+	UPROPERTY(EditDefaultsOnly, Category = "XRCore|XRCoreHand|HandTracking", meta = (ClampMin = "6", ClampMax = "15", EditCondition = "bReplicateHandJoints"))
+	int32 JointRotationPrecision = 10;
+
+	/*
+	* Multicast mode: the server forwards every Nth joint frame in full to the other clients and the frames in between as deltas against it.
+	* A lost key frame stalls the remote joints for up to this many frames. ReplicatedProperty mode always forwards full frames.
+	*/
+	UPROPERTY(EditDefaultsOnly, Category = "XRCore|XRCoreHand|HandTracking", meta = (ClampMin = "1", EditCondition = "bReplicateHandJoints"))
+	int32 JointKeyFrameInterval = 10;
+
+	/*
+	* Locally controlled only: provide the current local rotations of the 26 hand-tracking joints (EHandKeypoint order) for replication.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "XRCore|XRCoreHand")
+	void SetHandJointRotations(const TArray<FQuat>& InLocalRotations);
+
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	/*
 	* The HandType for this Hand.
@@ -84,6 +167,37 @@ protected:
 	UFUNCTION(NetMulticast, Unreliable)
 	void Multicast_UpdateHandData(FXRCoreHandReplicationData InXRCoreHandData);
 
+	void SendHandData();
+	bool ShouldSendHandData(const FVector& InLocation, const FQuat& InRotation) const;
+	void SendHandDataOnInputChange(float InAxisValue, float InLastSentAxisValue);
+	void UpdateReplicationMetrics(float InDeltaTime, const FVector& InLocation, const FQuat& InRotation);
+
+	FXRCoreHandReplicationData LastSentHandData;
+	FXRHandReplicationMetrics ReplicationMetrics;
+
+	// Joint Replication - the owner delta codes against the last frame the server acknowledged,
+	// the server forwards key frames and deltas against the last key frame, as other clients send no acks
+	void SendHandJoints();
+
+	UFUNCTION(Server, Unreliable)
+	void Server_UpdateHandJoints(const FXRHandJointPacket& InPacket);
+
+	UFUNCTION(Client, Unreliable)
+	void Client_AckHandJoints(uint16 InFrameId);
+
+	UFUNCTION(NetMulticast, Unreliable)
+	void Multicast_UpdateHandJoints(const FXRHandJointPacket& InPacket);
+
+	TArray<FQuat> PendingHandJoints;
+	bool bHasNewHandJoints = false;
+	uint16 NextJointFrameId = 1;
+	uint16 LastAckedJointFrameId = 0;
+	uint16 LastReceivedJointFrameId = 0;
+	FXRHandJointHistory SentJointFrames;
+	FXRHandJointHistory ReceivedJointFrames;
+	FXRHandJointKeyFrameEncoder ForwardEncoder;
+	FTimerHandle HandJointTimer;
+
 	UPROPERTY()
 	bool bIsLocallyControlled = false;
 
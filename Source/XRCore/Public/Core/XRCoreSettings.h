@@ -62,13 +62,90 @@ public:
 
 	/**
 	 * The replication interval, in seconds, for sending snapshots from the server to all clients. 
+	 * Used by XRReplicatedPhysicsComponents without a ReplicationProfile.
 	**/
-	UPROPERTY(EditDefaultsOnly, Category = "Physics Replication", meta = (ClampMin = "0.0"))
+	UPROPERTY(config, EditAnywhere, Category = "Physics Replication", meta = (ClampMin = "0.0"))
 	float DefaultReplicationInterval = 0.1f;
 
 	/**
 	 * The replication interval, in seconds, for when the Actor is currently interacted with.
+	 * Used by XRReplicatedPhysicsComponents without a ReplicationProfile.
 	 **/
-	UPROPERTY(EditDefaultsOnly, Category = "Physics Replication", meta = (ClampMin = "0.0"))
+	UPROPERTY(config, EditAnywhere, Category = "Physics Replication", meta = (ClampMin = "0.0"))
 	float InteractedReplicationInterval = 0.01f;
+
+	/**
+	 * Named replication profiles, assigned per XRReplicatedPhysicsComponent, e.g. a cheap profile for decorative props and a precise one for tools.
+	 * Override per platform in Config/<Platform>/<Platform>XRCore.ini.
+	 **/
+	UPROPERTY(config, EditAnywhere, Category = "Physics Replication")
+	TMap<FName, FXRReplicationProfile> ReplicationProfiles;
+
+	/**
+	 * Return the profile with this name. Unknown names and None return the default profile built from DefaultReplicationInterval and InteractedReplicationInterval.
+	 **/
+	FXRReplicationProfile GetReplicationProfile(FName InProfileName) const;
+
+	/**
+	 * Spawn the XRHighlightComponent of an XRInteractionComponent the first time it is hovered instead of at BeginPlay.
+	 * Highlight components are never spawned on a dedicated server, regardless of this setting.
+	**/
+	UPROPERTY(config, EditAnywhere, Category = "Performance")
+	bool bLazyHighlightCreation = true;
+
+	/**
+	 * Maximum number of AudioComponents kept per world for interaction sounds. When all are busy, the oldest sound is stolen.
+	**/
+	UPROPERTY(config, EditAnywhere, Category = "Performance", meta = (ClampMin = "1"))
+	int32 AudioPoolSize = 8;
+
+	/**
+	 * Maximum number of interaction sounds started in a single frame. Further requests in the same frame are dropped.
+	**/
+	UPROPERTY(config, EditAnywhere, Category = "Performance", meta = (ClampMin = "1"))
+	int32 MaxInteractionSoundsPerFrame = 4;
+
+	/**
+	 * Maximum number of laser targeting traces submitted per frame across all XRLaserComponents with native targeting.
+	 * Lasers over budget are traced in one of the following frames. 0 disables the budget.
+	**/
+	UPROPERTY(config, EditAnywhere, Category = "Performance", meta = (ClampMin = "0"))
+	int32 MaxLaserTracesPerFrame = 16;
+
+	/**
+	 * Queue the hover, start and end delegates of XRInteractors and XRInteractionComponents and broadcast them once per frame after all actors have ticked.
+	 * A hover and unhover of the same pair within one frame cancel out. Disable to broadcast them synchronously from the interaction call.
+	**/
+	UPROPERTY(config, EditAnywhere, Category = "Performance")
+	bool bDeferInteractionEvents = true;
+
+	/**
+	 * Number of grab joints kept per world by the XRConstraintPoolSubsystem. Released joints stay idle for reuse until the pool needs room.
+	**/
+	UPROPERTY(config, EditAnywhere, Category = "Performance", meta = (ClampMin = "1"))
+	int32 ConstraintPoolSize = 8;
+
+	/**
+	 * Drive strength of pooled grab joints, see XRInteractionGrab bUsePooledConstraints.
+	**/
+	UPROPERTY(config, EditAnywhere, Category = "Physics Grab", meta = (ClampMin = "0.0"))
+	float GrabLinearDriveStiffness = 5000.0f;
+
+	/**
+	 * Damping of the linear drive of pooled grab joints. Higher values settle the mesh faster but make it lag behind fast hand motion.
+	**/
+	UPROPERTY(config, EditAnywhere, Category = "Physics Grab", meta = (ClampMin = "0.0"))
+	float GrabLinearDriveDamping = 200.0f;
+
+	/**
+	 * Rotational drive strength of pooled grab joints, pulling the mesh towards its grabbed orientation.
+	**/
+	UPROPERTY(config, EditAnywhere, Category = "Physics Grab", meta = (ClampMin = "0.0"))
+	float GrabAngularDriveStiffness = 5000.0f;
+
+	/**
+	 * Damping of the rotational drive of pooled grab joints, reduces wobble around the grabbed orientation.
+	**/
+	UPROPERTY(config, EditAnywhere, Category = "Physics Grab", meta = (ClampMin = "0.0"))
+	float GrabAngularDriveDamping = 200.0f;
 };
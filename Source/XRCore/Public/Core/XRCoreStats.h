@@ -0,0 +1,45 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Stats/Stats.h"
+
+// ================================================================================================================================================================
+// Stat group and Insights trace scopes of XRCore hot paths. "stat XRCore" shows them in game, everything compiles out in Shipping.
+// ================================================================================================================================================================
+
+DECLARE_STATS_GROUP(TEXT("XRCore"), STATGROUP_XRCore, STATCAT_Advanced);
+
+// Cycle counters
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Interactor Overlaps"), STAT_XRCore_InteractorOverlaps, STATGROUP_XRCore, XRCORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Connector Overlaps"), STAT_XRCore_ConnectorOverlaps, STATGROUP_XRCore, XRCORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Priority Resolution"), STAT_XRCore_PriorityResolution, STATGROUP_XRCore, XRCORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Hologram Management"), STAT_XRCore_Holograms, STATGROUP_XRCore, XRCORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Highlight Updates"), STAT_XRCore_Highlights, STATGROUP_XRCore, XRCORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Physics ServerTick"), STAT_XRCore_PhysicsServerTick, STATGROUP_XRCore, XRCORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Physics ClientTick"), STAT_XRCore_PhysicsClientTick, STATGROUP_XRCore, XRCORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Hand Send"), STAT_XRCore_HandSend, STATGROUP_XRCore, XRCORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Hand Playback"), STAT_XRCore_HandPlayback, STATGROUP_XRCore, XRCORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Laser Targeting"), STAT_XRCore_LaserTargeting, STATGROUP_XRCore, XRCORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Grab Follow"), STAT_XRCore_GrabFollow, STATGROUP_XRCore, XRCORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Interactable Instances"), STAT_XRCore_InteractableInstances, STATGROUP_XRCore, XRCORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Interaction Events"), STAT_XRCore_InteractionEvents, STATGROUP_XRCore, XRCORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Trigger Scheduler"), STAT_XRCore_TriggerScheduler, STATGROUP_XRCore, XRCORE_API);
+
+// Sends per frame, counted by FXRCoreNetStats
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Hand Data Sends"), STAT_XRCore_HandDataSends, STATGROUP_XRCore, XRCORE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Hand Joint Sends"), STAT_XRCore_HandJointSends, STATGROUP_XRCore, XRCORE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Physics Snapshots"), STAT_XRCore_PhysicsSnapshots, STATGROUP_XRCore, XRCORE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Interaction Multicasts"), STAT_XRCore_InteractionMulticasts, STATGROUP_XRCore, XRCORE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Laser Input Packets"), STAT_XRCore_LaserInputPackets, STATGROUP_XRCore, XRCORE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Trigger State Changes"), STAT_XRCore_TriggerStateChanges, STATGROUP_XRCore, XRCORE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Connector State Changes"), STAT_XRCore_ConnectorStateChanges, STATGROUP_XRCore, XRCORE_API);
+
+#if !UE_BUILD_SHIPPING
+// Stat cycle counter plus a named Insights CPU event
+#define XRCORE_SCOPE_CYCLE_COUNTER(Stat) \
+	TRACE_CPUPROFILER_EVENT_SCOPE(Stat); \
+	SCOPE_CYCLE_COUNTER(Stat)
+#else
+#define XRCORE_SCOPE_CYCLE_COUNTER(Stat)
+#endif
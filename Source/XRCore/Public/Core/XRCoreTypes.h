@@ -43,6 +43,15 @@ enum class ESimplifiedControllerHand : uint8
 	Any UMETA(DisplayName = "Any Hand"),
 };
 
+UENUM(BlueprintType, Category = "XRCore")
+enum class EXRHandReplicationMode : uint8
+{
+	// Server multicasts every update to all clients
+	Multicast UMETA(DisplayName = "Multicast"),
+	// Server stores the latest update in a replicated property, skipping the owner and respecting relevancy and priority per connection
+	ReplicatedProperty UMETA(DisplayName = "Replicated Property"),
+};
+
 USTRUCT(BlueprintType, Category = "XRCore")
 struct FXRCoreHandReplicationData
 {
@@ -61,6 +70,99 @@ struct FXRCoreHandReplicationData
 	// Input data (for example grip), used for animation on remotes
 	UPROPERTY(BlueprintReadWrite, Category = "XRCore|Hand")
 	float SecondaryInputAxis = 0.0f;
+
+	// World time of the sending client when this data was captured, used to play back remote hands with correct spacing
+	UPROPERTY(BlueprintReadWrite, Category = "XRCore|Hand")
+	double Timestamp = 0.0;
+};
+
+// Send statistics of a locally controlled hand, to compare fixed and adaptive replication rates
+USTRUCT(BlueprintType, Category = "XRCore")
+struct FXRHandReplicationMetrics
+{
+	GENERATED_BODY()
+
+	// Seconds covered by these metrics
+	UPROPERTY(BlueprintReadOnly, Category = "XRCore|Hand")
+	float Duration = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "XRCore|Hand")
+	int32 NumSent = 0;
+
+	// Sends caused by an input axis change rather than motion or heartbeat
+	UPROPERTY(BlueprintReadOnly, Category = "XRCore|Hand")
+	int32 NumInputSends = 0;
+
+	// Average sends per second
+	UPROPERTY(BlueprintReadOnly, Category = "XRCore|Hand")
+	float SendRate = 0.0f;
+
+	// Distance (cm) between the tracked location and the last sent location, sampled every tick
+	UPROPERTY(BlueprintReadOnly, Category = "XRCore|Hand")
+	float AverageLocationError = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "XRCore|Hand")
+	float MaxLocationError = 0.0f;
+
+	// Angle (degrees) between the tracked rotation and the last sent rotation, sampled every tick
+	UPROPERTY(BlueprintReadOnly, Category = "XRCore|Hand")
+	float AverageRotationError = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "XRCore|Hand")
+	float MaxRotationError = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "XRCore|Hand")
+	int32 NumSamples = 0;
+};
+
+// -------------------------------------------------------------------------------------------------------------------------------------
+// Physics Replication
+// -------------------------------------------------------------------------------------------------------------------------------------
+UENUM(BlueprintType, Category = "XRCore")
+enum class EXRReplicationPrecision : uint8
+{
+	// Uncompressed location and rotation
+	Full UMETA(DisplayName = "Full"),
+	// Location to 0.01 cm, rotation to 16 bit per axis
+	High UMETA(DisplayName = "High"),
+	// Location to 0.1 cm, rotation to 16 bit per axis
+	Medium UMETA(DisplayName = "Medium"),
+	// Location to 1 cm, rotation to 8 bit per axis
+	Low UMETA(DisplayName = "Low"),
+};
+
+// Replication settings of a UXRReplicatedPhysicsComponent, see ReplicationProfiles in the XRCore settings
+USTRUCT(BlueprintType, Category = "XRCore")
+struct FXRReplicationProfile
+{
+	GENERATED_BODY()
+
+	// Seconds between snapshots while the owner moves
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "XRCore|Physics Replication", meta = (ClampMin = "0.0"))
+	float ReplicationInterval = 0.1f;
+
+	// Seconds between snapshots while the owner is interacted with
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "XRCore|Physics Replication", meta = (ClampMin = "0.0"))
+	float InteractedReplicationInterval = 0.01f;
+
+	// Quantization of snapshots. The packed modes clamp locations to roughly +-50 km (High), +-8 km (Medium) and +-5 km (Low) from the origin, opt in per profile.
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "XRCore|Physics Replication")
+	EXRReplicationPrecision Precision = EXRReplicationPrecision::Full;
+
+	// Seconds clients take to blend to a new snapshot. 0 uses twice the current replication interval.
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "XRCore|Physics Replication", meta = (ClampMin = "0.0"))
+	float InterpolationDelay = 0.0f;
+
+	// Clients hold the last snapshot, so a moving owner within this distance (cm) and angle (degrees) of it skips the snapshot. 0 always sends.
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "XRCore|Physics Replication", meta = (ClampMin = "0.0"))
+	float DeadReckoningThreshold = 0.0f;
+
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "XRCore|Physics Replication", meta = (ClampMin = "0.0"))
+	float DeadReckoningAngleThreshold = 0.0f;
+
+	// Seconds at rest before the owner goes net dormant, if the component enables net dormancy
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "XRCore|Physics Replication", meta = (ClampMin = "0.0"))
+	float DormancyTimeout = 1.0f;
 };
 
 UINTERFACE(MinimalAPI, BlueprintType, Category = "XRCore")
@@ -156,6 +258,21 @@ enum class EXRLaserState : uint8
 	Interact UMETA(DisplayName = "Interact"),
 };
 
+UENUM(BlueprintType, Category = "XRCore")
+enum class EXRLaserTraceShape : uint8
+{
+	Line UMETA(DisplayName = "Line Trace"),
+	Sphere UMETA(DisplayName = "Sphere Sweep"),
+};
+
+UENUM(BlueprintType, Category = "XRCore")
+enum class EXRLaserInputCommand : uint8
+{
+	StartInteraction UMETA(DisplayName = "Start Interaction"),
+	StopInteraction UMETA(DisplayName = "Stop Interaction"),
+	StopAllInteractions UMETA(DisplayName = "Stop All Interactions"),
+};
+
 UINTERFACE(MinimalAPI, BlueprintType, Category = "XRCore")
 class UXRLaserInterface : public UInterface
 {
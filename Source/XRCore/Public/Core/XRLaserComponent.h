@@ -2,17 +2,67 @@
 
 #include "CoreMinimal.h"
 #include "Components/SceneComponent.h"
+#include "Engine/EngineTypes.h"
+#include "WorldCollision.h"
+#include "TimerManager.h"
 
 #include "Core/XRCoreTypes.h"
 #include "Interactions/XRInteractorComponent.h"
 
 #include "XRLaserComponent.generated.h"
 
+class AXRInteractableInstances;
 class UXRLaserComponent;
+class UXRInteractionComponent;
 class UXRInteractorComponent;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnXRLaserSpawned, UXRLaserComponent*, Sender, bool, SpawnResult);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnXRLaserStateChanged, UXRLaserComponent*, Sender, bool, NewState);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnXRLaserTargetChanged, UXRLaserComponent*, Sender, UXRInteractionComponent*, TargetedXRInteraction);
+
+USTRUCT()
+struct FXRLaserInputCommand
+{
+	GENERATED_BODY()
+
+	// Not serialized, derived from the packets BaseSequence
+	uint16 Sequence = 0;
+
+	UPROPERTY()
+	EXRLaserInputCommand Command = EXRLaserInputCommand::StartInteraction;
+
+	UPROPERTY()
+	int32 Priority = 0;
+
+	UPROPERTY()
+	EXRInteractionPrioritySelection PrioritySelection = EXRInteractionPrioritySelection::Equal;
+};
+
+// Consecutive, sequence numbered interaction commands of one laser. Bit-packed: 16 bit base sequence, 4 bit count, ~1 byte per command.
+USTRUCT()
+struct FXRLaserInputPacket
+{
+	GENERATED_BODY()
+
+	static constexpr int32 MaxCommands = 15;
+
+	UPROPERTY()
+	uint16 BaseSequence = 0;
+
+	UPROPERTY()
+	TArray<FXRLaserInputCommand> Commands;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FXRLaserInputPacket> : public TStructOpsTypeTraitsBase2<FXRLaserInputPacket>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
 
 // ================================================================================================================================================================
 // Manages a XRLaser Actor (must implement IXRLaserInterface), interfaces with the InteractionSystem and UMG elements 
@@ -41,6 +91,73 @@ public:
 	UPROPERTY(EditAnywhere, Category = "XRCore|XRLaser")
 	EControllerHand XRControllerHand = EControllerHand::AnyHand;
 
+	/**
+	 * Interaction commands are sent unreliably and resent at this interval (seconds) until the server acknowledges them.
+	*/
+	UPROPERTY(EditAnywhere, Category = "XRCore|XRLaser", meta = (ClampMin = "0.01"))
+	float InputResendInterval = 0.05f;
+
+	// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+	// Config - Targeting
+	// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+	/**
+	 * Run laser targeting natively instead of in the XRLaser actor. Traces of all lasers in the world are batched by the UXRLaserTargetingSubsystem.
+	 * An async trace is issued while the laser is active on the locally controlled hand; its result is consumed the next frame.
+	 * Target changes are forwarded to the XRLaser actor via IXRInteractionInterface::HoverInteraction and broadcast via OnXRLaserTargetChanged.
+	 */
+	UPROPERTY(EditAnywhere, Category = "XRCore|XRLaser|Targeting")
+	bool bEnableNativeTargeting = false;
+
+	/**
+	 * Line: a single ray along the forward vector of this component.
+	 * Sphere: a sphere sweep with TraceRadius, more forgiving for small targets.
+	 */
+	UPROPERTY(EditAnywhere, Category = "XRCore|XRLaser|Targeting")
+	EXRLaserTraceShape TraceShape = EXRLaserTraceShape::Line;
+
+	/**
+	 * Radius of the sphere sweep. Only used if TraceShape is Sphere.
+	 */
+	UPROPERTY(EditAnywhere, Category = "XRCore|XRLaser|Targeting", meta = (ClampMin = "0.0", EditCondition = "TraceShape == EXRLaserTraceShape::Sphere"))
+	float TraceRadius = 2.0f;
+
+	/**
+	 * Maximum targeting distance in cm.
+	 */
+	UPROPERTY(EditAnywhere, Category = "XRCore|XRLaser|Targeting", meta = (ClampMin = "0.0"))
+	float TraceLength = 1000.0f;
+
+	UPROPERTY(EditAnywhere, Category = "XRCore|XRLaser|Targeting")
+	TEnumAsByte<ECollisionChannel> TraceChannel = ECC_Visibility;
+
+	/**
+	 * Seconds between targeting traces on the locally controlled hand. 0 traces every frame.
+	 */
+	UPROPERTY(EditAnywhere, Category = "XRCore|XRLaser|Targeting", meta = (ClampMin = "0.0"))
+	float LocalTargetingInterval = 0.0f;
+
+	/**
+	 * Also run targeting for lasers of remote players, e.g. to drive their laser visuals.
+	 */
+	UPROPERTY(EditAnywhere, Category = "XRCore|XRLaser|Targeting")
+	bool bTargetOnRemoteLasers = false;
+
+	/**
+	 * Seconds between targeting traces for lasers of remote players.
+	 */
+	UPROPERTY(EditAnywhere, Category = "XRCore|XRLaser|Targeting", meta = (ClampMin = "0.0", EditCondition = "bTargetOnRemoteLasers"))
+	float RemoteTargetingInterval = 0.1f;
+
+	/**
+	 * Return the XRInteraction currently targeted by native targeting, resolved with the same priority rules as the XRInteractor.
+	 * @param OutHitResult The hit that resolved to this target. Also valid if no XRInteraction was hit.
+	 */
+	UFUNCTION(BlueprintPure, Category = "XRCore|XRLaser|Targeting")
+	UXRInteractionComponent* GetLaserTarget(FHitResult& OutHitResult) const;
+
+	UPROPERTY(BlueprintAssignable, Category = "XRCore|XRLaser")
+	FOnXRLaserTargetChanged OnXRLaserTargetChanged;
+
 	// ------------------------------------------------------------------------------------------------------------------------------------------------------------
 	// API
 	// ------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -67,8 +184,16 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "XRCore|XRLaser")
 	FOnXRLaserStateChanged OnXRLaserStateChanged;
 
+	// Targeting steps, driven by the UXRLaserTargetingSubsystem
+	bool WantsTargetingTrace() const;
+	float GetTargetingInterval() const;
+	FTraceHandle RequestTargetingTrace();
+	void ProcessTargetingResult(const FTraceDatum& InTraceDatum);
+	void ClearLaserTarget();
+
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	UFUNCTION(Server, Reliable)
 	void Server_SetLaserActive(bool bInActive);
@@ -77,11 +202,24 @@ protected:
 	void Multicast_SetLaserActive(bool bInActive);
 
 
-	UFUNCTION(Server, Reliable)
-	void Server_RequestInteraction(int32 InID, int32 InPriority, EXRInteractionPrioritySelection InPrioritySelectionCondition);
+	// Interaction command stream: the owning client queues commands and resends them unreliably until acknowledged,
+	// the server applies each sequence exactly once and in order. Callers with authority apply directly.
+	void QueueInputCommand(EXRLaserInputCommand InCommand, int32 InPriority, EXRInteractionPrioritySelection InPrioritySelectionCondition);
+	void SendPendingInputCommands();
 
-	UFUNCTION(NetMulticast, Reliable)
-	void Multicast_RequestInteraction(int32 InID, int32 InPriority, EXRInteractionPrioritySelection InPrioritySelectionCondition);
+	UFUNCTION(Server, Unreliable)
+	void Server_SendInputPacket(const FXRLaserInputPacket& InPacket);
+
+	UFUNCTION(Client, Unreliable)
+	void Client_AckInputSequence(uint16 InSequence);
+
+	// Server only, the resulting interactions replicate through the XRInteractor
+	void ExecuteInputCommand(EXRLaserInputCommand InCommand, int32 InPriority, EXRInteractionPrioritySelection InPrioritySelectionCondition);
+
+	TArray<FXRLaserInputCommand> PendingInputCommands;
+	uint16 NextInputSequence = 1;
+	uint16 LastAppliedInputSequence = 0;
+	FTimerHandle InputResendTimer;
 
 	// Laser State
 	UPROPERTY(ReplicatedUsing = OnRep_IsLaserActive)
@@ -96,4 +234,27 @@ protected:
 	void OnRep_XRLaserActor();
 	UPROPERTY(ReplicatedUsing = OnRep_XRLaserActor)
 	AActor* XRLaserActor = nullptr;
+
+	// Targeting
+	bool IsLocallyControlled() const;
+	void SetLaserTarget(UXRInteractionComponent* InTarget);
+
+	// Lightweight items are promoted to their full actor when targeted, the next traces hit that actor
+	UPrimitiveComponent* ResolveInteractableInstance(AXRInteractableInstances* InInteractableInstances, int32 InInstanceIndex);
+
+	// Owning laser: request promotion of the targeted item, and keep it from being demoted while targeted. INDEX_NONE releases the previous item.
+	void RequestPromotion(AXRInteractableInstances* InInteractableInstances, int32 InItem);
+	// Server side of RequestPromotion
+	void ApplyPromotionRequest(AXRInteractableInstances* InInteractableInstances, int32 InItem);
+
+	UFUNCTION(Server, Reliable)
+	void Server_RequestPromotion(AXRInteractableInstances* InInteractableInstances, int32 InItem);
+
+	TWeakObjectPtr<AXRInteractableInstances> RequestedPromotionInstances = nullptr;
+	int32 RequestedPromotionItem = INDEX_NONE;
+	// Promoted actor of the requested item once it was seen, stale after it has been demoted or destroyed
+	TWeakObjectPtr<AActor> RequestedPromotionActor = nullptr;
+
+	FHitResult LaserTargetHit;
+	TWeakObjectPtr<UXRInteractionComponent> LaserTarget = nullptr;
 };
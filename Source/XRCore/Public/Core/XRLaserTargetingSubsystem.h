@@ -0,0 +1,77 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+
+#include "XRLaserTargetingSubsystem.generated.h"
+
+class UXRLaserComponent;
+
+USTRUCT(BlueprintType, Category = "XRCore")
+struct FXRLaserTargetingStats
+{
+	GENERATED_BODY()
+
+	// Lasers with native targeting currently registered
+	UPROPERTY(BlueprintReadOnly, Category = "XRCore|XRLaser")
+	int32 NumRegisteredLasers = 0;
+
+	// Async traces submitted in the last batch
+	UPROPERTY(BlueprintReadOnly, Category = "XRCore|XRLaser")
+	int32 NumTracesLastFrame = 0;
+
+	// Lasers that were due but pushed to the next frame because MaxLaserTracesPerFrame was reached
+	UPROPERTY(BlueprintReadOnly, Category = "XRCore|XRLaser")
+	int32 NumDeferredLastFrame = 0;
+
+	// Async traces submitted since this world started
+	UPROPERTY(BlueprintReadOnly, Category = "XRCore|XRLaser")
+	int64 TotalTraces = 0;
+};
+
+// ================================================================================================================================================================
+// Gathers the targeting traces of all XRLaserComponents each frame and submits them as one batch of async scene queries
+// ================================================================================================================================================================
+UCLASS()
+class XRCORE_API UXRLaserTargetingSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * Register a laser for batched targeting. Called by UXRLaserComponent at BeginPlay if native targeting is enabled.
+	 */
+	void RegisterLaser(UXRLaserComponent* InLaser);
+
+	/**
+	 * Remove a laser from batched targeting, discarding any trace still in flight.
+	 */
+	void UnregisterLaser(UXRLaserComponent* InLaser);
+
+	/**
+	 * Return the trace counters of this world, can be used to monitor the physics query cost of all lasers.
+	 */
+	UFUNCTION(BlueprintPure, Category = "XRCore|XRLaser")
+	FXRLaserTargetingStats GetTargetingStats() const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FXRLaserTargetingEntry
+	{
+		TWeakObjectPtr<UXRLaserComponent> Laser = nullptr;
+		FTraceHandle PendingTrace;
+		double NextTraceTime = 0.0;
+	};
+
+	void DispatchCompletedTraces(UWorld* InWorld);
+	void SubmitDueTraces(UWorld* InWorld);
+
+	TArray<FXRLaserTargetingEntry> Entries = {};
+	FXRLaserTargetingStats Stats = {};
+};
@@ -0,0 +1,195 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "GameFramework/Actor.h"
+#include "Net/Serialization/FastArraySerializer.h"
+
+#include "XRInteractableInstances.generated.h"
+
+class AXRInteractableInstances;
+class UXRLaserComponent;
+struct FXRInteractableInstanceStateArray;
+
+// Server state of an item that has been promoted at least once, replicated so clients show the same instances
+USTRUCT()
+struct FXRInteractableInstanceState : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 Item = INDEX_NONE;
+
+	UPROPERTY()
+	bool bPromoted = false;
+
+	// Transform of the instance while demoted
+	UPROPERTY()
+	FTransform Transform = FTransform::Identity;
+
+	// Actor replacing the instance while promoted, lets clients map a traced actor back to its item
+	UPROPERTY()
+	TWeakObjectPtr<AActor> PromotedActor = nullptr;
+
+	void PostReplicatedAdd(const FXRInteractableInstanceStateArray& InArraySerializer);
+	void PostReplicatedChange(const FXRInteractableInstanceStateArray& InArraySerializer);
+};
+
+// Delta replicated item states, clients only receive the items that changed since the last update
+USTRUCT()
+struct FXRInteractableInstanceStateArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FXRInteractableInstanceState> States;
+
+	// Set by the owning actor, not replicated
+	AXRInteractableInstances* Owner = nullptr;
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FXRInteractableInstanceState, FXRInteractableInstanceStateArray>(States, DeltaParms, *this);
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FXRInteractableInstanceStateArray> : public TStructOpsTypeTraitsBase2<FXRInteractableInstanceStateArray>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
+
+// ================================================================================================================================================================
+// Many identical interactable props rendered as instances, each promoted to a full PromotedActorClass actor while an XRInteractor is within range.
+// Items are kept in flat arrays; promoted actors are demoted back to an instance after they have been released, untargeted and at rest for DemotionDelay.
+// Promotion runs on the server, XRLaserComponents on clients request it for the items they target.
+// ================================================================================================================================================================
+UCLASS()
+class XRCORE_API AXRInteractableInstances : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AXRInteractableInstances();
+
+	// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+	// Config
+	// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+	/**
+	 * Full interactable actor (XRInteractionComponents, XRReplicatedPhysicsComponent, ...) spawned at the instance transform on promotion.
+	 * Should show the same mesh as the instances and replicate.
+	 */
+	UPROPERTY(EditAnywhere, Category = "XRCore|Interactable Instances")
+	TSubclassOf<AActor> PromotedActorClass;
+
+	/**
+	 * Items within this distance (cm) of any XRInteractor are promoted. Keep it above the interactor reach, so promoted actors have replicated before they are touched.
+	 */
+	UPROPERTY(EditAnywhere, Category = "XRCore|Interactable Instances", meta = (ClampMin = "0.0"))
+	float PromotionRadius = 100.0f;
+
+	/**
+	 * Seconds a promoted actor has to be out of range, not interacted with and at rest before it is demoted.
+	 */
+	UPROPERTY(EditAnywhere, Category = "XRCore|Interactable Instances", meta = (ClampMin = "0.0"))
+	float DemotionDelay = 2.0f;
+
+	/**
+	 * Seconds between promotion and demotion checks.
+	 */
+	UPROPERTY(EditAnywhere, Category = "XRCore|Interactable Instances", meta = (ClampMin = "0.0"))
+	float UpdateInterval = 0.1f;
+
+	// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+	// API
+	// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+	/**
+	 * Server: add an item at runtime, e.g. when filling a scene procedurally. Items authored as instances in the editor are added at BeginPlay.
+	 * @return The item index.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "XRCore|Interactable Instances")
+	int32 AddItem(const FTransform& InTransform);
+
+	/**
+	 * Server: replace the instance of this item by a PromotedActorClass actor. Returns the existing actor if already promoted.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "XRCore|Interactable Instances")
+	AActor* PromoteItem(int32 InItem);
+
+	/**
+	 * Server: destroy the promoted actor of this item and show an instance at its last transform.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "XRCore|Interactable Instances")
+	bool DemoteItem(int32 InItem);
+
+	/**
+	 * Return the item shown by this instance, e.g. FHitResult::Item of a trace against the instances. INDEX_NONE if invalid.
+	 */
+	UFUNCTION(BlueprintPure, Category = "XRCore|Interactable Instances")
+	int32 GetItemForInstance(int32 InInstanceIndex) const;
+
+	/**
+	 * Actor that replaced the instance of this item, on clients once it has replicated.
+	 */
+	UFUNCTION(BlueprintPure, Category = "XRCore|Interactable Instances")
+	AActor* GetPromotedActor(int32 InItem) const;
+
+	/**
+	 * Server: mark the item an XRLaser targets, it is not demoted while targeted. INDEX_NONE clears the target of this laser.
+	 */
+	void SetLaserTargetedItem(const UXRLaserComponent* InLaser, int32 InItem);
+
+	UFUNCTION(BlueprintPure, Category = "XRCore|Interactable Instances")
+	int32 GetNumItems() const;
+
+	UFUNCTION(BlueprintPure, Category = "XRCore|Interactable Instances")
+	int32 GetNumPromotedItems() const;
+
+	UHierarchicalInstancedStaticMeshComponent* GetInstances() const { return Instances; }
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void Tick(float DeltaSeconds) override;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+	UHierarchicalInstancedStaticMeshComponent* Instances;
+
+	// Client: the promoted actor left relevancy or was demoted, the instance stands in for it again
+	UFUNCTION()
+	void OnPromotedActorDestroyed(AActor* InDestroyedActor);
+
+private:
+	struct FXRInteractableItem
+	{
+		FTransform Transform = FTransform::Identity;
+		// INDEX_NONE while promoted
+		int32 InstanceIndex = INDEX_NONE;
+		TWeakObjectPtr<AActor> PromotedActor = nullptr;
+		float RestTime = 0.0f;
+	};
+
+	void ShowInstance(int32 InItem);
+	void HideInstance(int32 InItem);
+	void SetItemState(int32 InItem, bool bInPromoted);
+	void ApplyItemState(const FXRInteractableInstanceState& InState);
+	bool IsLaserTargeted(int32 InItem) const;
+	bool IsInPromotionRange(const FVector& InLocation, const TArray<FVector>& InInteractorLocations, float InRadiusScale) const;
+
+	TArray<FXRInteractableItem> Items = {};
+	// Parallel to the instances of the HISM, which swaps the last instance into removed slots
+	TArray<int32> InstanceToItem = {};
+	TArray<int32> PromotedItems = {};
+
+	UPROPERTY(Replicated)
+	FXRInteractableInstanceStateArray ItemStates;
+	TMap<int32, int32> ItemToStateIndex = {};
+
+	// Server: item targeted by each XRLaser, see SetLaserTargetedItem
+	TMap<TWeakObjectPtr<const UXRLaserComponent>, int32> LaserTargetedItems = {};
+
+	friend struct FXRInteractableInstanceState;
+};
@@ -9,6 +9,7 @@
 #include "Sound/SoundBase.h"
 
 #include "Interactions/XRInteractionTypes.h"
+#include "Utilities/XRAudioPoolSubsystem.h"
 
 #include "XRInteractionComponent.generated.h"
 
@@ -19,6 +20,7 @@ class UXRInteractionHighlightComponent;
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnInteractionStarted, UXRInteractionComponent*, Sender, UXRInteractorComponent*, XRInteractorComponent);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnInteractionEnded, UXRInteractionComponent*, Sender, UXRInteractorComponent*, XRInteractorComponent);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnInteractionHovered, UXRInteractionComponent*, Sender, UXRInteractorComponent*, HoveringXRInteractor, bool, bHovered);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnInteractionChangedNative, UXRInteractionComponent*, UXRInteractorComponent*);
 
 
 // ================================================================================================================================================================
@@ -47,6 +49,12 @@ public:
 	UPROPERTY(BlueprintAssignable, Category="XRCore|Interaction|Delegates")
 	FOnInteractionStarted OnInteractionStarted;
 
+	/**
+	 * Broadcast synchronously from StartInteraction, for C++ listeners that have to react before the interaction continues.
+	 * OnInteractionStarted may be deferred to the end of the frame, see bDeferInteractionEvents.
+	 */
+	FOnInteractionChangedNative OnInteractionStartedNative;
+
 	
 	/**
 	 * Will manually call the OnInteractionStop Event which should be overriden by the inheriting class with specific interaction behavior.
@@ -59,6 +67,11 @@ public:
 	UPROPERTY(BlueprintAssignable, Category="XRCore|Interaction|Delegates")
 	FOnInteractionEnded OnInteractionEnded;
 
+	/**
+	 * Broadcast synchronously from EndInteraction, see OnInteractionStartedNative.
+	 */
+	FOnInteractionChangedNative OnInteractionEndedNative;
+
 
 	/**
 	 * Will manually call the OnInteractionHovered Event which should be overriden by the inheriting class with specific interaction behavior.
@@ -94,6 +107,36 @@ public:
 	UFUNCTION(BlueprintPure, Category="XRCore|Interaction")
 	TArray<UXRInteractorComponent*> GetActiveInteractors() const;
 
+	/**
+	 * Number of XRInteractors currently interacting with this interaction. Does not allocate, prefer over GetActiveInteractors().Num().
+	 */
+	UFUNCTION(BlueprintPure, Category = "XRCore|Interaction")
+	int32 NumActiveInteractors() const;
+
+	using FXRInteractorArray = TArray<UXRInteractorComponent*, TInlineAllocator<4>>;
+
+	/**
+	 * Copy the valid active XRInteractors into an inline array, e.g. to stop them while the active set changes. Does not allocate for up to four interactors.
+	 */
+	void CopyActiveInteractors(FXRInteractorArray& OutInteractors) const;
+
+	/**
+	 * Return any valid active XRInteractor, nullptr if none. Does not allocate.
+	 */
+	UXRInteractorComponent* GetFirstActiveInteractor() const;
+
+	/**
+	 * Returns true if this XRInteractor is currently interacting with this interaction.
+	 */
+	UFUNCTION(BlueprintPure, Category = "XRCore|Interaction")
+	bool IsInteractedWithBy(const UXRInteractorComponent* InInteractor) const;
+
+	/**
+	 * Number of XRInteractors currently hovering this interaction. Does not allocate, prefer over IsHovered.
+	 */
+	UFUNCTION(BlueprintPure, Category = "XRCore|Interaction")
+	int32 NumHoveringInteractors() const;
+
 	/**
 	* Return what happens when this interaction is active and a second XRInteractor starts interacting.
 	* Allow: Allow multiple Interactors
@@ -111,6 +154,8 @@ public:
 
 	/**
 	 * Return the assigned XRInteractionHighlightComponent. Only valid if bEnableHighlighting is true on BeginPlay.
+	 * With bLazyHighlightCreation enabled in the XRCore settings, this is nullptr until the interaction is hovered for the first time.
+	 * Always nullptr on a dedicated server.
 	 */
 	UFUNCTION(BlueprintPure, Category = "XRCore|Interaction|Highlight")
 	UXRHighlightComponent* GetXRHighlightComponent();
@@ -138,6 +183,14 @@ public:
 protected:
 	virtual void InitializeComponent() override;
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/**
+	 * Server: send the changed replicated state of the owner even while an XRReplicatedPhysicsComponent keeps it net dormant.
+	 * Call after changing replicated properties of an interaction, the owner falls back to dormancy once they are sent.
+	 */
+	UFUNCTION(BlueprintCallable, Category="XRCore|Interaction")
+	void FlushOwnerNetDormancy();
 
 	// ------------------------------------------------------------------------------------------------------------------------------------------------------------
 	// Abstract Interaction Events 
@@ -209,7 +262,8 @@ protected:
 	// ------------------------------------------------------------------------------------------------------------------------------------------------------------
 	/**
 	 * Enable Material based Highlighting for this Interaction.
-	 * Spawn an XRInteractionHighlight on BeginPlay and set this interaction as it`s assigned Interaction if true at BeginPlay.
+	 * Spawn an XRInteractionHighlight and set this interaction as it`s assigned Interaction if true at BeginPlay.
+	 * The XRInteractionHighlight is spawned on BeginPlay or on first hover, depending on bLazyHighlightCreation in the XRCore settings.
 	 */
 	UPROPERTY(EditAnywhere, Category = "XRCore|Interaction|Highlighting")
 	bool bEnableHighlighting = true;
@@ -245,8 +299,8 @@ protected:
 	UPROPERTY(EditAnywhere, Category = "XRCore|Interaction|Audio")
 	USoundBase* InteractionEndSound = nullptr;
 
-	UPROPERTY()
-	UAudioComponent* CurrentAudioComponent = nullptr;
+	// Pooled voice of the last sound started by this interaction, see UXRAudioPoolSubsystem
+	FXRAudioVoiceHandle CurrentAudioVoice;
 
 	UFUNCTION()
 	void RequestAudioPlay(USoundBase* InSound);
@@ -259,9 +313,9 @@ private:
 	UPROPERTY()
 	TArray<UMeshComponent*> InteractionCollision = {};
 	
-	UPROPERTY()
-	TArray<TWeakObjectPtr<UXRInteractorComponent>> ActiveInteractors = {};
+	// Rarely more than two hands and a laser, kept inline
+	using FXRInteractorSet = TSet<TWeakObjectPtr<UXRInteractorComponent>, DefaultKeyFuncs<TWeakObjectPtr<UXRInteractorComponent>>, TInlineSetAllocator<4>>;
 
-	UPROPERTY()
-	TArray<TWeakObjectPtr<UXRInteractorComponent>> HoveringInteractors = {};
+	FXRInteractorSet ActiveInteractors;
+	FXRInteractorSet HoveringInteractors;
 };
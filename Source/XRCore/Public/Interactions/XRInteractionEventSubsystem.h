@@ -0,0 +1,74 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "XRInteractionEventSubsystem.generated.h"
+
+class UXRInteractionComponent;
+class UXRInteractorComponent;
+
+// Delegate broadcast of an XRInteractor or XRInteractionComponent
+enum class EXRInteractionEvent : uint8
+{
+	// UXRInteractorComponent::OnHoverStateChanged
+	InteractorHover,
+	// UXRInteractorComponent::OnStartedInteracting
+	InteractorStarted,
+	// UXRInteractorComponent::OnStoppedInteracting
+	InteractorStopped,
+	// UXRInteractionComponent::OnInteractionHovered
+	InteractionHover,
+	// UXRInteractionComponent::OnInteractionStarted
+	InteractionStarted,
+	// UXRInteractionComponent::OnInteractionEnded
+	InteractionEnded,
+};
+
+// ================================================================================================================================================================
+// Collects the interaction delegate broadcasts of a frame and dispatches them in one batch after all actors have ticked.
+// A hover and unhover of the same pair within the frame cancel out. Disable bDeferInteractionEvents in the XRCore settings to broadcast synchronously.
+// ================================================================================================================================================================
+UCLASS()
+class XRCORE_API UXRInteractionEventSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * Queue the broadcast, or broadcast immediately if events are not deferred or the world has no event subsystem.
+	 * @param bInState Hover state for the hover events, ignored otherwise.
+	 */
+	static void Post(const UObject* InWorldContext, EXRInteractionEvent InEvent, UXRInteractorComponent* InInteractor, UXRInteractionComponent* InInteraction, bool bInState = false);
+
+	/**
+	 * Broadcast all queued events now. Events posted by listeners during the flush are dispatched with the next one.
+	 */
+	void Flush();
+
+	int32 GetNumQueuedEvents() const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FXRQueuedInteractionEvent
+	{
+		EXRInteractionEvent Event = EXRInteractionEvent::InteractorHover;
+		TWeakObjectPtr<UXRInteractorComponent> Interactor = nullptr;
+		TWeakObjectPtr<UXRInteractionComponent> Interaction = nullptr;
+		bool bState = false;
+	};
+
+	void Enqueue(const FXRQueuedInteractionEvent& InEvent);
+	static void Broadcast(const FXRQueuedInteractionEvent& InEvent);
+	static bool IsHoverEvent(EXRInteractionEvent InEvent);
+
+	TArray<FXRQueuedInteractionEvent> QueuedEvents = {};
+	TArray<FXRQueuedInteractionEvent> DispatchingEvents = {};
+	bool bDeferEvents = true;
+};
@@ -3,6 +3,7 @@
 #include "CoreMinimal.h"
 
 #include "Interactions/XRInteractionComponent.h"
+#include "Utilities/XRConstraintPoolSubsystem.h"
 
 #include "XRInteractionGrab.generated.h"
 
@@ -27,6 +28,7 @@ public:
     /**
     * Enable Replicated Physics. 
     * Actor MUST have a UStaticMeshComponent as the RootComponent. 
+    * Without physics the actor is moved kinematically and its transform is still replicated by the XRReplicatedPhysicsComponent.
     */
     UPROPERTY(EditAnywhere, Category = "XRCore|Interaction")
     bool bEnablePhysics = true;
@@ -38,7 +40,44 @@ public:
     FName PhysicsTag = "XRPhysics";
 
     /**
-    * Return the Component handling PhysicsReplication for this Interaction. If bEnablePhysics is true, this component will be spawned at BeginPlay().
+    * Without physics, keep the grabbed actor unattached and move it to the XRInteractor each frame via the XRGrabFollowSubsystem instead of attaching it.
+    * Avoids attachment and overlap updates of the whole component tree on grab; overlaps are updated once on release.
+    * Colliders with XRInteractionComponents and all colliders of actors with an XRConnectorComponent keep generating overlaps while carried.
+    */
+    UPROPERTY(EditAnywhere, Category = "XRCore|Interaction", meta = (EditCondition = "!bEnablePhysics"))
+    bool bFollowInsteadOfAttach = false;
+
+    /**
+    * Hold the grabbed mesh with a joint from the XRConstraintPoolSubsystem instead of the PhysicsConstraint of the XRInteractor.
+    * Pooled joints are reused when the same XRInteractor grabs the same mesh again. Drive strength is set in the XRCore settings.
+    */
+    UPROPERTY(EditAnywhere, Category = "XRCore|Interaction", meta = (EditCondition = "bEnablePhysics"))
+    bool bUsePooledConstraints = false;
+
+    /**
+    * When a second XRInteractor grabs, drive the mesh towards one target derived from both XRInteractors instead of adding a second joint.
+    * The server moves the mesh through its physics velocity, clients receive the result as regular physics snapshots.
+    * Requires MultiInteractorBehavior Enabled.
+    */
+    UPROPERTY(EditAnywhere, Category = "XRCore|Interaction", meta = (EditCondition = "bEnablePhysics"))
+    bool bEnableTwoHandedGrab = false;
+
+    /**
+    * Rate (1/s) at which the two-handed drive closes the distance to its target. Higher is stiffer.
+    */
+    UPROPERTY(EditAnywhere, Category = "XRCore|Interaction", meta = (ClampMin = "1.0", EditCondition = "bEnableTwoHandedGrab"))
+    float TwoHandedFollowRate = 30.0f;
+
+    /**
+    * Is this grab currently held and driven by two XRInteractors.
+    */
+    UFUNCTION(BlueprintPure, Category = "XRCore|Interaction")
+    bool IsTwoHandedGrabActive() const;
+
+    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+    /**
+    * Return the Component handling PhysicsReplication for this Interaction. Spawned at BeginPlay() if the owner has none.
     */
     UFUNCTION(BlueprintPure, Category = "XRCore|Interaction")
     UXRReplicatedPhysicsComponent* GetPhysicsReplicationComponent();
@@ -59,26 +98,32 @@ protected:
     UFUNCTION()
     void DetachOwningActorFromXRInteractor();
 
+    void KinematicGrab();
+    void KinematicUngrab();
+
     UFUNCTION()
     void PhysicsGrab(UXRInteractorComponent* InInteractor);
     UFUNCTION()
     void PhysicsUngrab(UXRInteractorComponent* InInteractor);
 
+    void ReleaseGrabJoint(UXRInteractorComponent* InInteractor);
+    UPrimitiveComponent* GetPhysicsGrabMesh() const;
 
-    /**
-    * This is used to ensure proper LateJoining for non-physics grab
-    */
-    UPROPERTY(ReplicatedUsing = OnRep_GrabActorTransform)
-    FTransform GrabActorTransform;
-    UFUNCTION()
-    void OnRep_GrabActorTransform(); 
+    // Two-handed grab
+    void StartTwoHandedGrab();
+    void StopTwoHandedGrab();
+    static FTransform GetTwoHandedGripFrame(const USceneComponent* InFirst, const USceneComponent* InSecond);
 
-    UFUNCTION(Server, Reliable)
-    void Server_UpdateGrabActorTransform();
-
-    virtual void GetLifetimeReplicatedProps(TArray< FLifetimeProperty >& OutLifetimeProps) const override;
 
 private:
     UFUNCTION()
     void InitializePhysics();
+
+    // Pooled joints per grabbing XRInteractor
+    TMap<TWeakObjectPtr<UXRInteractorComponent>, FXRConstraintHandle> PooledConstraints;
+
+    TWeakObjectPtr<UXRInteractorComponent> TwoHandedInteractors[2];
+    // Pose of the mesh relative to the grip frame of both XRInteractors when the second one grabbed
+    FTransform TwoHandedMeshOffset;
+    bool bIsTwoHandedGrabActive = false;
 };
@@ -17,10 +17,39 @@ enum class EXRInteractionTriggerBehavior : uint8
     Hold UMETA(DisplayName = "Hold"),
 };
 
+UENUM(BlueprintType)
+enum class EXRInteractionTriggerPhase : uint8
+{
+    // Not interacted with
+    Idle UMETA(DisplayName = "Idle"),
+    // Interacted with until the last XRInteractor stops (Hold, or no InteractionDuration)
+    Held UMETA(DisplayName = "Held"),
+    // Timed Trigger/Toggle press, further presses are ignored until InteractionDuration has passed
+    Cooldown UMETA(DisplayName = "Cooldown"),
+};
+
+// Replicated trigger state, state and phase travel together with the server time the phase was entered
+USTRUCT(BlueprintType)
+struct FXRInteractionTriggerState
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "XRCore|Interaction")
+    bool bTriggerState = false;
+
+    UPROPERTY(BlueprintReadOnly, Category = "XRCore|Interaction")
+    EXRInteractionTriggerPhase Phase = EXRInteractionTriggerPhase::Idle;
+
+    // Server world time (seconds) the current phase was entered
+    UPROPERTY(BlueprintReadOnly, Category = "XRCore|Interaction")
+    float ChangeTime = 0.0f;
+};
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnTriggerStateChanged, UXRInteractionTrigger*, Sender, bool, TriggerState, UXRInteractorComponent*, Interactor);
 
 // ================================================================================================================================================================
 // Trigger Interaction, state keeping switch with multiple modes
+// The server runs the state machine, the end of a cooldown is scheduled by the XRTriggerSchedulerSubsystem.
 // ================================================================================================================================================================
 
 UCLASS(ClassGroup = (XRToolkit), meta = (BlueprintSpawnableComponent))
@@ -53,6 +82,20 @@ public:
     UFUNCTION(BlueprintPure, Category = "XRCore|Interaction")
     bool GetTriggerState() const;
 
+    UFUNCTION(BlueprintPure, Category = "XRCore|Interaction")
+    EXRInteractionTriggerPhase GetTriggerPhase() const;
+
+    /**
+    * Progress of the current cooldown from 0 to 1, derived from the replicated change time. 1 if not in cooldown.
+    */
+    UFUNCTION(BlueprintPure, Category = "XRCore|Interaction")
+    float GetCooldownProgress() const;
+
+    /**
+    * Called by the XRTriggerSchedulerSubsystem at the scheduled end of a cooldown. Ignored if the trigger is no longer waiting for InScheduledTime.
+    */
+    void OnCooldownElapsed(double InScheduledTime);
+
     /**
     * Set the Triggers Behavior.
     * Not Replicated - set this on all Clients/Server manually as it is assumed that the OwningActor does not have authority.
@@ -98,17 +141,18 @@ protected:
     // ------------------------------------------------------------------------------------------------------------------------------------------------------------
 
     UPROPERTY(ReplicatedUsing = OnRep_TriggerState)
-    bool bTriggerState;
+    FXRInteractionTriggerState TriggerState;
 
     UFUNCTION()
-    void OnRep_TriggerState();
+    void OnRep_TriggerState(const FXRInteractionTriggerState& PreviousTriggerState);
 
-    UFUNCTION(BlueprintCallable, Category = "XRCore|Interaction")
-    void EndInteractionAfterTimer();
     UFUNCTION(BlueprintCallable, Category = "XRCore|Interaction")
     void RequestInteractionTermination();
     // ------------------------------------------------------------------------------------------------------------------------------------------------------------
 
 private:
-    FTimerHandle CooldownTimerHandle;
+    /**
+    * Server: move to the state and phase, schedule the end of a new cooldown and broadcast OnTriggerStateChanged once if the state changed.
+    */
+    void ApplyTriggerState(bool InTriggerState, EXRInteractionTriggerPhase InPhase, UXRInteractorComponent* InInteractor);
 };
@@ -47,6 +47,13 @@ enum class EXRMultiInteractorBehavior : uint8
 	TakeOver UMETA(DisplayName = "Take over from current Interactor"),
 };
 
+UENUM(BlueprintType)
+enum class EXRInteractorProximityMode : uint8
+{
+	OverlapEvents UMETA(DisplayName = "Overlap Events"),
+	Query UMETA(DisplayName = "Overlap Query per Frame"),
+};
+
 
 // ------------------------------------------------------------------------------------------------------------------------------------------------------------
 // Interaction Interface: implemented by XRInteractor, XRLaser for starting and stopping interactions from user input
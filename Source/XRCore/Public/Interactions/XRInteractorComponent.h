@@ -93,6 +93,18 @@ public:
 	UFUNCTION(BlueprintPure, Category="XRCore|Interactor")
 	TArray<UXRInteractionComponent*> GetActiveInteractions() const; 
 
+	/**
+	 * Returns true if this Interactor is currently interacting with this Interaction. Does not allocate.
+	 */
+	UFUNCTION(BlueprintPure, Category="XRCore|Interactor")
+	bool IsInteractingWith(const UXRInteractionComponent* InInteraction) const;
+
+	/**
+	 * Returns true if this Interactor is currently hovering this Interaction. Does not allocate.
+	 */
+	UFUNCTION(BlueprintPure, Category="XRCore|Interactor")
+	bool IsHovering(const UXRInteractionComponent* InInteraction) const;
+
 	/**
 	 * Returns true and the highest priority InteractionComponent on the provided Actor or, if no Actor is provided, on all Actors this Interactor is currently overlapping.
 	 * @param InActor - If provided, will for this Actor. Otherwise, the currently overlapped actors will be checked.
@@ -175,15 +187,20 @@ public:
 	UFUNCTION(BlueprintPure, Category="XRCore|Interactor")
 	UPhysicsConstraintComponent* GetPhysicsConstraint() const;
 	
+	/**
+	 * OverlapEvents: hover follows the overlap events of this sphere and the AdditionalColliders.
+	 * Query: overlap events are turned off on this sphere and the AdditionalColliders. Every frame runs one overlap query per collider
+	 * and only components that entered or left since the last frame are hovered / unhovered. Components of the owning actor are ignored.
+	*/
+	UPROPERTY(EditDefaultsOnly, Category = "XRCore|Interactor")
+	EXRInteractorProximityMode ProximityMode = EXRInteractorProximityMode::OverlapEvents;
 
 	
 protected:
 	virtual void InitializeComponent() override;
 	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type) override;
-
-	UFUNCTION()
-	TArray<UXRInteractionComponent*> GetChildXRInteractionComponents(UPrimitiveComponent* InComponent);
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
 	UPROPERTY()
 	TArray<UPrimitiveComponent*> AdditionalColliders = {};
@@ -218,10 +235,10 @@ private:
 	UPhysicsConstraintComponent* PhysicsConstraint;
 	UPROPERTY()
 	AActor* LocalInteractedActor = nullptr;
-	UPROPERTY(Transient)
-	TArray<TWeakObjectPtr<UXRInteractionComponent>> ActiveInteractionComponents = {};
-	UPROPERTY()
-	TArray<TWeakObjectPtr<UXRInteractionComponent>> HoveredInteractionComponents = {};
+
+	using FXRInteractionSet = TSet<TWeakObjectPtr<UXRInteractionComponent>, DefaultKeyFuncs<TWeakObjectPtr<UXRInteractionComponent>>, TInlineSetAllocator<8>>;
+	FXRInteractionSet ActiveInteractionComponents;
+	FXRInteractionSet HoveredInteractionComponents;
 
 	UFUNCTION()
 	void OnOverlapBegin(UPrimitiveComponent* OverlappedComp, AActor* OtherActor,
@@ -229,4 +246,12 @@ private:
 	UFUNCTION()
 	void OnOverlapEnd(UPrimitiveComponent* OverlappedComp, AActor* OtherActor,
 		UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
+
+	// Query proximity mode
+	using FProximityComponentSet = TSet<TWeakObjectPtr<UPrimitiveComponent>, DefaultKeyFuncs<TWeakObjectPtr<UPrimitiveComponent>>, TInlineSetAllocator<16>>;
+
+	void UpdateProximityQuery();
+	void GetProximityComponents(TArray<UPrimitiveComponent*>& OutComponents) const;
+
+	FProximityComponentSet ProximityComponents;
 };
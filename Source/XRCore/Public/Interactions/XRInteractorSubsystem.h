@@ -0,0 +1,36 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "XRInteractorSubsystem.generated.h"
+
+class UXRInteractorComponent;
+
+// ================================================================================================================================================================
+// Per-world list of the XRInteractors that have begun play, so systems that look for nearby interactors don't have to iterate all objects
+// ================================================================================================================================================================
+UCLASS()
+class XRCORE_API UXRInteractorSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Called by UXRInteractorComponent at BeginPlay.
+	 */
+	void RegisterInteractor(UXRInteractorComponent* InInteractor);
+
+	/**
+	 * Called by UXRInteractorComponent at EndPlay.
+	 */
+	void UnregisterInteractor(UXRInteractorComponent* InInteractor);
+
+	const TArray<TWeakObjectPtr<UXRInteractorComponent>>& GetInteractors() const { return Interactors; }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	TArray<TWeakObjectPtr<UXRInteractorComponent>> Interactors = {};
+};
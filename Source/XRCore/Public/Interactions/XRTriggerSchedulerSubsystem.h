@@ -0,0 +1,47 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "XRTriggerSchedulerSubsystem.generated.h"
+
+class UXRInteractionTrigger;
+
+// ================================================================================================================================================================
+// Ends the cooldown of XRInteractionTriggers at their scheduled world time. One heap per world instead of a timer per trigger, so panels of thousands of buttons stay cheap.
+// ================================================================================================================================================================
+UCLASS()
+class XRCORE_API UXRTriggerSchedulerSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * Call InTrigger->OnCooldownElapsed(InTime) once the world time reaches InTime (seconds).
+	 * Entries are not removed when a trigger changes its mind, the trigger ignores times it no longer waits for.
+	 */
+	void ScheduleCooldownEnd(UXRInteractionTrigger* InTrigger, double InTime);
+
+	int32 GetNumScheduled() const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FXRScheduledTrigger
+	{
+		double Time = 0.0;
+		TWeakObjectPtr<UXRInteractionTrigger> Trigger = nullptr;
+
+		bool operator<(const FXRScheduledTrigger& Other) const
+		{
+			return Time < Other.Time;
+		}
+	};
+
+	// Min-heap on Time
+	TArray<FXRScheduledTrigger> ScheduledTriggers = {};
+};
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/AudioComponent.h"
+#include "Sound/SoundBase.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "XRAudioPoolSubsystem.generated.h"
+
+/**
+ * Handle to a voice of the UXRAudioPoolSubsystem. Becomes stale once the voice is reused or stolen by another request.
+ */
+struct FXRAudioVoiceHandle
+{
+	int32 VoiceIndex = INDEX_NONE;
+	uint32 Serial = 0;
+
+	bool IsSet() const { return VoiceIndex != INDEX_NONE; }
+};
+
+// ================================================================================================================================================================
+// Per-world pool of AudioComponents for short interaction sounds, with voice stealing and a per-frame playback cap
+// ================================================================================================================================================================
+UCLASS()
+class XRCORE_API UXRAudioPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/**
+	 * Play a sound at the given location on a pooled voice. Steals the oldest voice if all voices are busy.
+	 * Returns an unset handle if nothing was played: no sound, no audio device (dedicated server) or the per-frame cap was reached.
+	 */
+	FXRAudioVoiceHandle PlaySoundAtLocation(USoundBase* InSound, const FVector& InLocation);
+
+	/**
+	 * Stop the voice referenced by this handle. Ignored if the voice has been reused since.
+	 */
+	void StopVoice(const FXRAudioVoiceHandle& InHandle);
+
+	/**
+	 * Return true if the voice referenced by this handle is still playing the sound it was requested for.
+	 */
+	bool IsVoicePlaying(const FXRAudioVoiceHandle& InHandle) const;
+
+	/**
+	 * Number of AudioComponents created by the pool so far (never exceeds AudioPoolSize in the XRCore settings).
+	 */
+	int32 GetNumVoices() const;
+
+	/**
+	 * Number of pooled AudioComponents that are currently playing.
+	 */
+	int32 GetNumActiveVoices() const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	bool CanPlayAudio() const;
+	int32 AcquireVoiceIndex();
+	UAudioComponent* CreateVoice();
+	bool IsHandleCurrent(const FXRAudioVoiceHandle& InHandle) const;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UAudioComponent>> Voices = {};
+
+	// Parallel to Voices
+	TArray<uint32> VoiceSerials = {};
+	TArray<double> VoiceStartTimes = {};
+
+	uint32 NextSerial = 1;
+	uint64 CurrentPlaybackFrame = 0;
+	int32 PlaybacksThisFrame = 0;
+	int32 MaxVoices = 8;
+	int32 MaxPlaybacksPerFrame = 4;
+};
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/PrimitiveComponent.h"
+#include "PhysicsEngine/ConstraintInstance.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "XRConstraintPoolSubsystem.generated.h"
+
+/**
+ * Handle to a joint of the UXRConstraintPoolSubsystem. Becomes stale once the joint is released.
+ */
+struct FXRConstraintHandle
+{
+	int32 ConstraintIndex = INDEX_NONE;
+	uint32 Serial = 0;
+
+	bool IsSet() const { return ConstraintIndex != INDEX_NONE; }
+	void Reset() { ConstraintIndex = INDEX_NONE; Serial = 0; }
+};
+
+USTRUCT(BlueprintType, Category = "XRCore")
+struct FXRConstraintPoolStats
+{
+	GENERATED_BODY()
+
+	// Joints currently existing in the physics scene, in use or idle
+	UPROPERTY(BlueprintReadOnly, Category = "XRCore|Physics")
+	int32 NumConstraints = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "XRCore|Physics")
+	int32 NumInUse = 0;
+
+	// Acquires that re-enabled the idle joint of the same interactor and mesh
+	UPROPERTY(BlueprintReadOnly, Category = "XRCore|Physics")
+	int32 NumReused = 0;
+
+	// Acquires that had to create a joint
+	UPROPERTY(BlueprintReadOnly, Category = "XRCore|Physics")
+	int32 NumCreated = 0;
+
+	// Idle joints destroyed to make room for another pair
+	UPROPERTY(BlueprintReadOnly, Category = "XRCore|Physics")
+	int32 NumEvicted = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "XRCore|Physics")
+	float AverageAcquireMicroseconds = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "XRCore|Physics")
+	float AverageReleaseMicroseconds = 0.0f;
+};
+
+// ================================================================================================================================================================
+// Per-world pool of grab joints. Joints are pre-configured with free motion and position drives, releasing only zeroes the drives
+// and restores collision between the bodies, so grabbing the same mesh with the same interactor again re-enables the existing joint instead of creating a new one
+// ================================================================================================================================================================
+UCLASS()
+class XRCORE_API UXRConstraintPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/**
+	 * Drive InMesh towards its current pose relative to InInteractor. Both components need a physics body.
+	 * Returns an unset handle if no joint could be created.
+	 */
+	FXRConstraintHandle AcquireConstraint(UPrimitiveComponent* InInteractor, UPrimitiveComponent* InMesh);
+
+	/**
+	 * Zero the drives of the joint, let the two bodies collide again and keep the joint idle for reuse. Resets the handle.
+	 */
+	void ReleaseConstraint(FXRConstraintHandle& InOutHandle);
+
+	/**
+	 * Update the drive strength of an acquired joint in place. Stiffness and damping of 0 let the mesh move freely.
+	 */
+	void SetDriveParams(const FXRConstraintHandle& InHandle, float InLinearStiffness, float InLinearDamping, float InAngularStiffness, float InAngularDamping);
+
+	/**
+	 * Move the drive target of an acquired joint: the pose of the mesh relative to the interactor.
+	 */
+	void SetRelativeTarget(const FXRConstraintHandle& InHandle, const FTransform& InMeshRelativeToInteractor);
+
+	UFUNCTION(BlueprintPure, Category = "XRCore|Physics")
+	FXRConstraintPoolStats GetPoolStats() const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FXRPooledConstraint
+	{
+		// Heap allocated, the physics joint keeps a pointer to its instance
+		TUniquePtr<FConstraintInstance> Constraint;
+		TWeakObjectPtr<UPrimitiveComponent> Interactor = nullptr;
+		TWeakObjectPtr<UPrimitiveComponent> Mesh = nullptr;
+		uint32 Serial = 0;
+		bool bInUse = false;
+		double LastReleaseTime = 0.0;
+	};
+
+	int32 FindReusableIndex(UPrimitiveComponent* InInteractor, UPrimitiveComponent* InMesh) const;
+	int32 FindFreeIndex();
+	bool InitJoint(FXRPooledConstraint& InEntry, UPrimitiveComponent* InInteractor, UPrimitiveComponent* InMesh);
+	void TermJoint(FXRPooledConstraint& InEntry);
+	void ConfigureConstraintProfile(FConstraintInstance& InConstraint) const;
+	void SetDrivesEnabled(FConstraintInstance& InConstraint, bool bInEnabled) const;
+	FXRPooledConstraint* GetEntry(const FXRConstraintHandle& InHandle);
+
+	UFUNCTION()
+	void OnPooledComponentPhysicsStateChanged(UPrimitiveComponent* InChangedComponent, EComponentPhysicsStateChange InStateChange);
+
+	TArray<FXRPooledConstraint> Entries = {};
+	uint32 NextSerial = 1;
+	int32 PoolSize = 8;
+
+	FXRConstraintPoolStats Stats = {};
+	int32 NumAcquireSamples = 0;
+	int32 NumReleaseSamples = 0;
+};
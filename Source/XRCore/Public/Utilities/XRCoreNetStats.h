@@ -0,0 +1,133 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+class UScriptStruct;
+
+// Net counters are development only, recording compiles to nothing in Shipping
+#define XRCORE_WITH_NET_STATS !UE_BUILD_SHIPPING
+
+// Replication paths of XRCore, counted separately by FXRCoreNetStats
+enum class EXRNetFeature : uint8
+{
+	HandData,
+	HandJoints,
+	PhysicsSnapshot,
+	InteractionMulticast,
+	LaserInput,
+	TriggerState,
+	ConnectorState,
+	Num
+};
+
+struct FXRNetFeatureStats
+{
+	int64 NumMessages = 0;
+	// Serialized payload bytes times the connections each message went to, without packet, bunch and property headers. Only counted while tracking.
+	int64 NumBytes = 0;
+	// Messages whose size is an estimate rather than serialized, e.g. object references that are net GUIDs of varying size on the wire
+	int64 NumEstimatedMessages = 0;
+};
+
+// ================================================================================================================================================================
+// Process wide counters of XRCore network traffic, recorded where each feature sends. Listen server and PIE clients in one process share them.
+// ================================================================================================================================================================
+class XRCORE_API FXRCoreNetStats
+{
+public:
+	/**
+	 * Counts one send of InFeature. Use XRCORE_RECORD_NET_MESSAGE, which only sizes the message while tracking is enabled.
+	 */
+	static void RecordMessage(EXRNetFeature InFeature);
+
+	/**
+	 * Adds the bytes of one send: InNumBytes per copy for each of InNumReceivers connections. bInEstimated flags the feature as estimated in reports.
+	 */
+	static void RecordBytes(EXRNetFeature InFeature, int32 InNumBytes, int32 InNumReceivers, bool bInEstimated);
+
+	/**
+	 * Receivers of a server RPC sent through InActor: the server when called on a client, none when the caller already is the server.
+	 */
+	static int32 GetNumServerReceivers(AActor* InActor);
+
+	/**
+	 * Receivers of a multicast or replicated property of InActor on the server: client connections with an open or dormant channel for it.
+	 */
+	static int32 GetNumClientReceivers(AActor* InActor, bool bInSkipOwner = false);
+
+	/**
+	 * Bytes InStruct writes as an RPC parameter or replicated property, through its NetSerialize if it has one.
+	 * Structs holding object references need a package map and can not be sized this way.
+	 */
+	static int32 GetNetSerializedBytes(const UScriptStruct* InStruct, void* InData);
+
+	template<typename T>
+	static int32 GetNetSerializedBytes(T& InValue)
+	{
+		return GetNetSerializedBytes(T::StaticStruct(), &InValue);
+	}
+
+	/**
+	 * Client: seconds from receiving a physics snapshot until the actor visually reached it.
+	 */
+	static void RecordSnapshotLatency(double InSeconds);
+
+	/**
+	 * Server: remember when snapshot InSnapshotId of the actor with net GUID InActorKey was sent.
+	 * Client: measure the time since it was sent once it is shown. Both ends must run in this process (PIE, listen server with clients).
+	 * Both do nothing unless tracking is enabled.
+	 */
+	static void RecordSnapshotSent(uint32 InActorKey, uint32 InSnapshotId);
+	static void RecordSnapshotShown(uint32 InActorKey, uint32 InSnapshotId);
+
+	/**
+	 * Messages are only sized and snapshot send times only kept while tracking is enabled.
+	 * xrcore.netbench enables it for the length of a run, xrcore.net track toggles it by hand.
+	 */
+	static void SetTrackingEnabled(bool bInEnabled);
+	static bool IsTrackingEnabled();
+
+	static FXRNetFeatureStats GetFeatureStats(EXRNetFeature InFeature);
+	static double GetAverageSnapshotLatency();
+	static double GetMaxSnapshotLatency();
+	static const TCHAR* GetFeatureName(EXRNetFeature InFeature);
+
+	static void Reset();
+
+private:
+	struct FSnapshotSendTime
+	{
+		uint32 ActorKey = 0;
+		uint32 SnapshotId = 0;
+		double SendTime = 0.0;
+	};
+
+	// Ring of recent send times, slot chosen by snapshot sequence. A newer snapshot overwrites whatever shared its slot.
+	static constexpr int32 NumSnapshotSendTimes = 1024;
+
+	static FXRNetFeatureStats FeatureStats[static_cast<int32>(EXRNetFeature::Num)];
+	static double TotalSnapshotLatency;
+	static double MaxSnapshotLatency;
+	static int64 NumSnapshotLatencySamples;
+	static bool bTrackingEnabled;
+	static FSnapshotSendTime SnapshotSendTimes[NumSnapshotSendTimes];
+};
+
+// NumBytes and NumReceivers are only evaluated while tracking. Use the _ESTIMATE variant where the size is not serialized.
+#if XRCORE_WITH_NET_STATS
+#define XRCORE_RECORD_NET_MESSAGE_IMPL(Feature, NumBytes, NumReceivers, bEstimated) \
+	do \
+	{ \
+		FXRCoreNetStats::RecordMessage(Feature); \
+		if (FXRCoreNetStats::IsTrackingEnabled()) \
+		{ \
+			FXRCoreNetStats::RecordBytes(Feature, NumBytes, NumReceivers, bEstimated); \
+		} \
+	} while (0)
+#define XRCORE_RECORD_NET_MESSAGE(Feature, NumBytes, NumReceivers) XRCORE_RECORD_NET_MESSAGE_IMPL(Feature, NumBytes, NumReceivers, false)
+#define XRCORE_RECORD_NET_MESSAGE_ESTIMATE(Feature, NumBytes, NumReceivers) XRCORE_RECORD_NET_MESSAGE_IMPL(Feature, NumBytes, NumReceivers, true)
+#else
+#define XRCORE_RECORD_NET_MESSAGE(Feature, NumBytes, NumReceivers)
+#define XRCORE_RECORD_NET_MESSAGE_ESTIMATE(Feature, NumBytes, NumReceivers)
+#endif
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "XRDebugRegistrySubsystem.generated.h"
+
+// ================================================================================================================================================================
+// Per-world lists of the XRCore components and actors that have begun play, read by the xrcore.* debug commands and xrcore.debug.draw
+// instead of iterating all objects. Not created in Shipping, registering is a failed subsystem lookup there.
+// ================================================================================================================================================================
+UCLASS()
+class XRCORE_API UXRDebugRegistrySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Called at BeginPlay and EndPlay. T is the class InObject is listed under, so subclasses are found by ForEach of their XRCore base class.
+	 */
+	template<typename T>
+	static void Register(T* InObject)
+	{
+		if (UXRDebugRegistrySubsystem* Registry = Get(InObject))
+		{
+			Registry->RegisteredObjects.FindOrAdd(T::StaticClass()).Add(InObject);
+		}
+	}
+
+	template<typename T>
+	static void Unregister(T* InObject)
+	{
+		if (UXRDebugRegistrySubsystem* Registry = Get(InObject))
+		{
+			if (TSet<TWeakObjectPtr<UObject>>* Objects = Registry->RegisteredObjects.Find(T::StaticClass()))
+			{
+				Objects->Remove(InObject);
+			}
+		}
+	}
+
+	template<typename T>
+	void ForEach(TFunctionRef<void(T*)> InFunction) const
+	{
+		if (const TSet<TWeakObjectPtr<UObject>>* Objects = RegisteredObjects.Find(T::StaticClass()))
+		{
+			for (const TWeakObjectPtr<UObject>& Object : *Objects)
+			{
+				if (T* TypedObject = Cast<T>(Object.Get()))
+				{
+					InFunction(TypedObject);
+				}
+			}
+		}
+	}
+
+	template<typename T>
+	int32 Num() const
+	{
+		const TSet<TWeakObjectPtr<UObject>>* Objects = RegisteredObjects.Find(T::StaticClass());
+		return Objects ? Objects->Num() : 0;
+	}
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	static UXRDebugRegistrySubsystem* Get(const UObject* InWorldContextObject);
+
+	TMap<const UClass*, TSet<TWeakObjectPtr<UObject>>> RegisteredObjects = {};
+};
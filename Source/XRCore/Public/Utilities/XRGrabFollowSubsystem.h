@@ -0,0 +1,57 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "XRGrabFollowSubsystem.generated.h"
+
+class UPrimitiveComponent;
+
+// ================================================================================================================================================================
+// Moves all unattached, non-physics grabbed actors of a world to their XRInteractor once per frame, with overlap updates deferred until release
+// ================================================================================================================================================================
+UCLASS()
+class XRCORE_API UXRGrabFollowSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * Keep InActor at its current offset to InTarget until StopFollowing is called. Calling again for the same actor re-anchors it to the new target.
+	 * Overlap events of the actors primitive components are suspended while following.
+	 */
+	void StartFollowing(AActor* InActor, USceneComponent* InTarget);
+
+	/**
+	 * Stop moving InActor, restore its overlap events and run a single overlap update at its final transform.
+	 */
+	void StopFollowing(AActor* InActor);
+
+	bool IsFollowing(const AActor* InActor) const;
+
+	/**
+	 * Number of actors currently moved by this subsystem.
+	 */
+	int32 GetNumFollowers() const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FXRGrabFollower
+	{
+		TWeakObjectPtr<AActor> Actor = nullptr;
+		TWeakObjectPtr<USceneComponent> Target = nullptr;
+		FTransform RelativeTransform = FTransform::Identity;
+		// Components whose overlap events were suspended while following
+		TArray<TWeakObjectPtr<UPrimitiveComponent>> SuspendedOverlapComponents;
+	};
+
+	FXRGrabFollower* FindFollower(const AActor* InActor);
+	void RestoreOverlaps(FXRGrabFollower& InFollower);
+
+	TArray<FXRGrabFollower> Followers = {};
+};
@@ -0,0 +1,162 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "XRHandJointCompression.generated.h"
+
+namespace XRHandJoints
+{
+	// OpenXR hand joints, same order as EHandKeypoint
+	constexpr int32 NumJoints = 26;
+
+	constexpr int32 MinPrecision = 6;
+	constexpr int32 MaxPrecision = 15;
+
+	// Frame ids wrap around, 0 is reserved for the rest pose
+	inline bool IsNewerFrame(uint16 InFrameId, uint16 InReferenceFrameId)
+	{
+		return static_cast<int16>(static_cast<uint16>(InFrameId - InReferenceFrameId)) > 0;
+	}
+}
+
+/**
+ * Joint rotation relative to the rest pose, smallest-three quantized: the index of the largest quaternion component
+ * and the remaining three components with Precision bits each. Default constructed equals the rest pose.
+ */
+struct FXRQuantizedJointRotation
+{
+	uint8 LargestIndex = 3;
+	int16 Components[3] = { 0, 0, 0 };
+
+	bool operator==(const FXRQuantizedJointRotation& Other) const
+	{
+		return LargestIndex == Other.LargestIndex && Components[0] == Other.Components[0] && Components[1] == Other.Components[1] && Components[2] == Other.Components[2];
+	}
+	bool operator!=(const FXRQuantizedJointRotation& Other) const { return !(*this == Other); }
+};
+
+// Hand joint frame, only carrying the joints that differ from its baseline frame
+USTRUCT()
+struct FXRHandJointPacket
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	uint16 FrameId = 0;
+
+	// Frame the changed joints are coded against, 0 codes against the rest pose (full frame)
+	UPROPERTY()
+	uint16 BaselineFrameId = 0;
+
+	// Bits per quantized quaternion component
+	UPROPERTY()
+	uint8 Precision = 10;
+
+	UPROPERTY()
+	uint32 ChangedJointMask = 0;
+
+	// One entry per bit set in ChangedJointMask, ascending joint order
+	TArray<FXRQuantizedJointRotation> ChangedJoints;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+	// Size of this packet on the wire
+	int32 GetNumBits() const;
+};
+
+template<>
+struct TStructOpsTypeTraits<FXRHandJointPacket> : public TStructOpsTypeTraitsBase2<FXRHandJointPacket>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
+
+// ================================================================================================================================================================
+// Quantization and delta coding of hand joint frames
+// ================================================================================================================================================================
+struct XRCORE_API FXRHandJointCodec
+{
+	static FXRQuantizedJointRotation Quantize(const FQuat& InRotation, int32 InPrecision);
+	static FQuat Dequantize(const FXRQuantizedJointRotation& InRotation, int32 InPrecision);
+
+	/**
+	 * Quantize local joint rotations relative to the rest pose. An empty rest pose is treated as identity.
+	 */
+	static void QuantizeFrame(const TArray<FQuat>& InLocalRotations, const TArray<FQuat>& InRestPose, int32 InPrecision, TArray<FXRQuantizedJointRotation>& OutFrame);
+	static void DequantizeFrame(const TArray<FXRQuantizedJointRotation>& InFrame, const TArray<FQuat>& InRestPose, int32 InPrecision, TArray<FQuat>& OutLocalRotations);
+
+	/**
+	 * Write the joints of InFrame that differ from InBaseline into OutPacket. A null baseline codes against the rest pose.
+	 */
+	static void EncodeDelta(const TArray<FXRQuantizedJointRotation>& InFrame, const TArray<FXRQuantizedJointRotation>* InBaseline, FXRHandJointPacket& OutPacket);
+
+	/**
+	 * Reconstruct the full quantized frame from a packet and the baseline it was coded against. Returns false for malformed packets.
+	 */
+	static bool DecodeDelta(const FXRHandJointPacket& InPacket, const TArray<FXRQuantizedJointRotation>* InBaseline, TArray<FXRQuantizedJointRotation>& OutFrame);
+
+	/**
+	 * Largest angular difference in degrees between two sets of joint rotations, used to measure reconstruction error.
+	 */
+	static float GetMaxAngularErrorDegrees(const TArray<FQuat>& InExpected, const TArray<FQuat>& InActual);
+};
+
+/**
+ * Last quantized frames of a joint stream by FrameId, used as baselines for delta coding.
+ */
+class XRCORE_API FXRHandJointHistory
+{
+public:
+	void Add(uint16 InFrameId, const TArray<FXRQuantizedJointRotation>& InFrame);
+	const TArray<FXRQuantizedJointRotation>* Find(uint16 InFrameId) const;
+	void Reset();
+
+private:
+	static constexpr int32 Capacity = 16;
+
+	struct FEntry
+	{
+		uint16 FrameId = 0;
+		TArray<FXRQuantizedJointRotation> Frame;
+	};
+	FEntry Entries[Capacity];
+	int32 NextEntry = 0;
+};
+
+/**
+ * Sending side of a joint stream to receivers that send no acks (unreliable multicast): a full key frame every InKeyFrameInterval frames
+ * and on precision changes, deltas against the last key frame in between. Deltas name their key frame in BaselineFrameId.
+ */
+class XRCORE_API FXRHandJointKeyFrameEncoder
+{
+public:
+	void Encode(uint16 InFrameId, uint8 InPrecision, const TArray<FXRQuantizedJointRotation>& InFrame, int32 InKeyFrameInterval, FXRHandJointPacket& OutPacket);
+	void Reset();
+
+private:
+	uint16 KeyFrameId = 0;
+	uint8 KeyFramePrecision = 0;
+	int32 FramesSinceKeyFrame = 0;
+	TArray<FXRQuantizedJointRotation> KeyFrame;
+};
+
+/**
+ * Receiving side of a joint stream: full frames are applied and kept as key frame, deltas only against the key frame they name.
+ * Stale frames and deltas against a key frame that never arrived are dropped until the next key frame.
+ */
+class XRCORE_API FXRHandJointKeyFrameDecoder
+{
+public:
+	/**
+	 * Return true and the reconstructed frame if the packet is newer than the last applied one and its key frame is known.
+	 */
+	bool Decode(const FXRHandJointPacket& InPacket, TArray<FXRQuantizedJointRotation>& OutFrame);
+	void Reset();
+
+private:
+	uint16 KeyFrameId = 0;
+	uint16 LastAppliedFrameId = 0;
+	TArray<FXRQuantizedJointRotation> KeyFrame;
+};
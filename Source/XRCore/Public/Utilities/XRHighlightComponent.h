@@ -21,6 +21,7 @@ public:
 	UXRHighlightComponent();
 
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
 	// ------------------------------------------------------------------------------------------------------------------------------------------------------------
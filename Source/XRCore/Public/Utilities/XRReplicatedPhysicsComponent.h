@@ -9,12 +9,15 @@
 #include "Components/SkeletalMeshComponent.h"
 #include "Components/ActorComponent.h"
 
+#include "Core/XRCoreTypes.h"
+
 #include "XRReplicatedPhysicsComponent.generated.h"
 
 
 // ================================================================================================================================================================
 // Snapshot based, Server authoritative physics replication system
 // This component can be added to any replicated actor with a StaticMeshComponent as the root
+// Also replicates kinematically moved actors (non-physics grab) when bSimulatePhysics is disabled
 // ================================================================================================================================================================
 
 USTRUCT(BlueprintType, Category = "XRCore")
@@ -33,6 +36,21 @@ struct FXRPhysicsSnapshot
 
 	UPROPERTY(BlueprintReadWrite, Category = "XRCore|Physics")
 	FRotator Rotation = {};
+
+	// Quantization of Location and Rotation on the wire, from the replication profile of the sender
+	UPROPERTY()
+	EXRReplicationPrecision Precision = EXRReplicationPrecision::Full;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FXRPhysicsSnapshot> : public TStructOpsTypeTraitsBase2<FXRPhysicsSnapshot>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
 };
 
 
@@ -63,7 +81,7 @@ public:
 	/**
 	 * Marks the owner as InteractedWith, increasing/decreasing the replication interval. 
 	 * Only Relevant on the Server.
-	 * Set in XRCore Plugin Settings DefaultReplicationInterval and InteractedReplicationInterval
+	 * The intervals come from the ReplicationProfile of this component.
 	 **/
 	UFUNCTION(BlueprintCallable, Category = "XRCore|Physics Replication")
 	void SetInteractedWith(bool bInInteracedWith);
@@ -74,6 +92,62 @@ public:
 	UFUNCTION(BlueprintPure, Category = "XRCore|Physics Replication")
 	bool GetInteractedWith() const;
 
+	/**
+	 * Mark the owner as moved locally on this machine, e.g. attached to or following a local XRInteractor.
+	 * While set, snapshots taken during an interaction are not applied; the rest snapshot sent on release is.
+	 * Not Replicated.
+	 **/
+	UFUNCTION(BlueprintCallable, Category = "XRCore|Physics Replication")
+	void SetDrivenLocally(bool bInDrivenLocally);
+
+	UFUNCTION(BlueprintPure, Category = "XRCore|Physics Replication")
+	bool IsDrivenLocally() const;
+
+	/**
+	 * Replication profile from the XRCore settings (interval, precision, interpolation, dead reckoning, dormancy timeout).
+	 * None uses DefaultReplicationInterval and InteractedReplicationInterval.
+	 **/
+	UPROPERTY(EditAnywhere, ReplicatedUsing = OnRep_ReplicationProfile, Category = "XRCore|Physics Replication", meta = (GetOptions = "GetReplicationProfileNames"))
+	FName ReplicationProfile = NAME_None;
+
+	/**
+	 * Switch to another replication profile at runtime, e.g. to a precise profile while the owner is used as a tool.
+	 * Call on the server, clients follow through replication.
+	 **/
+	UFUNCTION(BlueprintCallable, Category = "XRCore|Physics Replication")
+	void SetReplicationProfile(FName InReplicationProfile);
+
+	/**
+	 * Put the owner to DORM_DormantAll once it has been at rest and not interacted with for the DormancyTimeout of its profile.
+	 * Dormant owners cost no replication until they are woken by a grab, movement, ForceUpdate or a connector detach.
+	 **/
+	UPROPERTY(EditAnywhere, Category = "XRCore|Physics Replication")
+	bool bEnableNetDormancy = true;
+
+	/**
+	 * Server: wake the owner from net dormancy. Call before changing replicated state on the owner while it might be dormant.
+	 **/
+	UFUNCTION(BlueprintCallable, Category = "XRCore|Physics Replication")
+	void WakeNetDormancy();
+
+	/**
+	 * Server: is the owner currently dormant because it came to rest.
+	 **/
+	UFUNCTION(BlueprintPure, Category = "XRCore|Physics Replication")
+	bool IsNetDormant() const;
+
+	/**
+	 * Snapshots per second sent (server) or received (client), averaged over recent snapshots. Used to tune the replication intervals.
+	 **/
+	UFUNCTION(BlueprintPure, Category = "XRCore|Physics Replication")
+	float GetSnapshotRate() const;
+
+	/**
+	 * Client: distance (cm) between the shown location and the latest snapshot after the last tick.
+	 **/
+	UFUNCTION(BlueprintPure, Category = "XRCore|Physics Replication")
+	float GetInterpolationError() const;
+
 	// ------------------------------------------------------------------------------------------------------------------------------------------------------------
 	// Colliders/Sim on Owner
 	// ------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -98,6 +172,13 @@ public:
 	UPROPERTY(EditAnywhere, Category = "XRCore|Physics Replication")
 	FName RegisterMeshComponentsWithTag = "";
 
+	/**
+	 * Simulate physics on the registered meshes of the server. If disabled, the owner is moved kinematically (e.g. by a non-physics XRInteractionGrab)
+	 * and this component only replicates its transform, without toggling physics simulation.
+	 **/
+	UPROPERTY(EditAnywhere, Category = "XRCore|Physics Replication")
+	bool bSimulatePhysics = true;
+
 	/**
 	 * Find and Cache all UMeshComponents with the given tag - can be accessed with GetRegisteredMeshComponents.
 	 * Does not set Simulate Physics. Use SetSimulatePhysics() for this.
@@ -123,6 +204,7 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
 	UFUNCTION()
@@ -142,15 +224,31 @@ protected:
 	UFUNCTION()
 	void OnRep_PhysicsActive();
 
+	UFUNCTION()
+	void OnRep_ReplicationProfile();
+
+	UFUNCTION()
+	TArray<FName> GetReplicationProfileNames() const;
+
 private:
 	UFUNCTION(Server, Reliable)
 	void Server_SetReplicatedSnapshot(FXRPhysicsSnapshot InReplicatedSnapshot);
 
 	float AccumulatedTime = 0.0f;
+	float RestTime = 0.0f;
+
+	// Debug counters
+	void RecordSnapshotTiming();
+	double LastSnapshotTime = 0.0;
+	float AverageSnapshotInterval = 0.0f;
+	float InterpolationError = 0.0f;
 
 	bool bIsInteractedWith = false;
-	float DefaultReplicationInterval = 0.0f;
-	float InteractedReplicationInterval = 0.0f;
+	bool bDrivenLocally = false;
+	FXRReplicationProfile ActiveProfile = {};
+
+	FXRPhysicsSnapshot MakeSnapshot(bool bInInteractedWith) const;
+	bool IsWithinDeadReckoningThreshold() const;
 
 	UPROPERTY(ReplicatedUsing = OnRep_ReplicatedSnapshot)
 	FXRPhysicsSnapshot ReplicatedSnapshot = {};
@@ -163,6 +261,8 @@ private:
 	UFUNCTION()
 	void OnRep_ReplicatedSnapshot();
 
+	bool ShouldApplySnapshot(const FXRPhysicsSnapshot& InSnapshot) const;
+
 	UPROPERTY()
 	TArray<UMeshComponent*> RegisteredMeshComponents = {};
 };
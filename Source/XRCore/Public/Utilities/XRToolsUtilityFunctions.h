@@ -58,6 +58,13 @@ public:
 	static UXRInteractionComponent* GetXRInteractionByPriority(const TArray<UXRInteractionComponent*>& InInteractions, UXRInteractorComponent* InXRInteractor = nullptr, int32 InPriority = 0, 
 		EXRInteractionPrioritySelection InPrioritySelectionCondition = EXRInteractionPrioritySelection::LowerEqual, int32 MaxSecondaryPriority = 5);
 
+	/**
+	 * Returns all XRInteractionComponents that are (recursive) children of the provided component.
+	 * This is how XRInteractors and XRLasers map an overlapped or traced collider to its interactions.
+	 */
+	UFUNCTION(BlueprintPure, Category = "XRCore|Utilities")
+	static TArray<UXRInteractionComponent*> GetChildXRInteractions(USceneComponent* InComponent);
+
 	/**
 	 * Returns true if this Actor has an XRInteractorComponent
 	 * @param InXRInteractor Optional, provide to validate if the interaction are avilable to this XRInteractor specifically
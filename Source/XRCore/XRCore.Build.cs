@@ -27,6 +27,7 @@ public class XRCore : ModuleRules
 			{
 				"Core", 
 				"InputCore",
+				"NetCore",
 				"OpenXRHMD",
 				"OpenXRInput"
 			}
@@ -0,0 +1,119 @@
+#include "XRCoreReplicationGraph.h"
+#include "Connections/XRConnectorSocket.h"
+#include "Core/XRCoreHand.h"
+#include "Utilities/XRReplicatedPhysicsComponent.h"
+
+#include "Engine/NetConnection.h"
+#include "GameFramework/Actor.h"
+
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Graph
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+void UXRCoreReplicationGraph::InitGlobalActorClassSettings()
+{
+	Super::InitGlobalActorClassSettings();
+
+	// Hand relevancy is resolved by UXRReplicationGraphNode_NearbyHands, the grid cull distance does not apply
+	FClassReplicationInfo HandInfo;
+	HandInfo.ReplicationPeriodFrame = FMath::Max(HandReplicationPeriodFrame, 1);
+	HandInfo.SetCullDistanceSquared(0.0f);
+	GlobalActorReplicationInfoMap.SetClassInfo(AXRCoreHand::StaticClass(), HandInfo);
+}
+
+void UXRCoreReplicationGraph::InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection)
+{
+	Super::InitConnectionGraphNodes(RepGraphConnection);
+
+	UXRReplicationGraphNode_NearbyHands* NearbyHandsNode = CreateNewNode<UXRReplicationGraphNode_NearbyHands>();
+	NearbyHandsNode->Graph = this;
+	AddConnectionGraphNode(NearbyHandsNode, RepGraphConnection);
+}
+
+void UXRCoreReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo)
+{
+	if (AXRCoreHand* Hand = Cast<AXRCoreHand>(ActorInfo.Actor))
+	{
+		Hands.AddUnique(Hand);
+		return;
+	}
+	if (IsStaticSocketActor(ActorInfo.Actor))
+	{
+		GridNode->AddActor_Static(ActorInfo, GlobalInfo);
+		return;
+	}
+	// Physics props fall through to dormancy based spatialization
+	Super::RouteAddNetworkActorToNodes(ActorInfo, GlobalInfo);
+}
+
+void UXRCoreReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo)
+{
+	if (AXRCoreHand* Hand = Cast<AXRCoreHand>(ActorInfo.Actor))
+	{
+		Hands.RemoveSwap(Hand);
+		return;
+	}
+	if (IsStaticSocketActor(ActorInfo.Actor))
+	{
+		GridNode->RemoveActor_Static(ActorInfo);
+		return;
+	}
+	Super::RouteRemoveNetworkActorToNodes(ActorInfo);
+}
+
+const TArray<TWeakObjectPtr<AXRCoreHand>>& UXRCoreReplicationGraph::GetHands() const
+{
+	return Hands;
+}
+
+// Sockets on movable props are routed with their props
+bool UXRCoreReplicationGraph::IsStaticSocketActor(const AActor* InActor) const
+{
+	if (!InActor || InActor->bAlwaysRelevant || InActor->bOnlyRelevantToOwner)
+	{
+		return false;
+	}
+	return InActor->FindComponentByClass<UXRConnectorSocket>() && !InActor->FindComponentByClass<UXRReplicatedPhysicsComponent>();
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Nearby hands
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+void UXRReplicationGraphNode_NearbyHands::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params)
+{
+	if (!Graph)
+	{
+		return;
+	}
+
+	ReplicationActorList.Reset();
+	const UNetConnection* NetConnection = Params.ConnectionManager.NetConnection;
+	for (const TWeakObjectPtr<AXRCoreHand>& WeakHand : Graph->GetHands())
+	{
+		AXRCoreHand* Hand = WeakHand.Get();
+		if (!Hand)
+		{
+			continue;
+		}
+		if (Hand->GetNetConnection() == NetConnection)
+		{
+			ReplicationActorList.Add(Hand);
+			continue;
+		}
+
+		const FVector HandLocation = Hand->GetActorLocation();
+		const float CullDistanceSquared = FMath::Square(Hand->GetHandNetCullDistance());
+		for (const FNetViewer& Viewer : Params.Viewers)
+		{
+			if (FVector::DistSquared(Viewer.ViewLocation, HandLocation) <= CullDistanceSquared)
+			{
+				ReplicationActorList.Add(Hand);
+				break;
+			}
+		}
+	}
+
+	if (ReplicationActorList.Num() > 0)
+	{
+		Params.OutGatheredReplicationLists.AddReplicationActorList(ReplicationActorList);
+	}
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BasicReplicationGraph.h"
+#include "ReplicationGraph.h"
+
+#include "XRCoreReplicationGraph.generated.h"
+
+class AXRCoreHand;
+class UXRCoreReplicationGraph;
+
+// ================================================================================================================================================================
+// Replication graph for XRCore sessions. Enable it in DefaultEngine.ini:
+// [/Script/OnlineSubsystemUtils.IpNetDriver]
+// ReplicationDriverClassName="/Script/XRCoreNet.XRCoreReplicationGraph"
+//
+// XRCoreHands: only gathered for their owner and for viewers within their HandNetCullDistance
+// Actors with a XRReplicatedPhysicsComponent: spatialized by dormancy, dormant props are treated as static and skipped until woken
+// Actors with XRConnectorSockets (without physics): static spatial
+// Everything else: as UBasicReplicationGraph
+// ================================================================================================================================================================
+UCLASS(transient, config = Engine)
+class XRCORENET_API UXRCoreReplicationGraph : public UBasicReplicationGraph
+{
+	GENERATED_BODY()
+
+public:
+	virtual void InitGlobalActorClassSettings() override;
+	virtual void InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection) override;
+	virtual void RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo) override;
+	virtual void RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo) override;
+
+	/**
+	 * All hands currently routed by this graph, shared by the per-connection UXRReplicationGraphNode_NearbyHands.
+	 */
+	const TArray<TWeakObjectPtr<AXRCoreHand>>& GetHands() const;
+
+	/**
+	 * Frames between replication of XRCoreHands. Hand data itself is already rate limited by the sending XRCoreHandComponent.
+	 */
+	UPROPERTY(config)
+	int32 HandReplicationPeriodFrame = 1;
+
+private:
+	bool IsStaticSocketActor(const AActor* InActor) const;
+
+	TArray<TWeakObjectPtr<AXRCoreHand>> Hands = {};
+};
+
+// ================================================================================================================================================================
+// Per connection: gathers the hands owned by this connection and all hands within their HandNetCullDistance of one of its viewers
+// ================================================================================================================================================================
+UCLASS()
+class XRCORENET_API UXRReplicationGraphNode_NearbyHands : public UReplicationGraphNode
+{
+	GENERATED_BODY()
+
+public:
+	virtual void NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo) override {}
+	virtual bool NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound = true) override { return false; }
+	virtual void NotifyResetAllNetworkActors() override {}
+
+	virtual void GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) override;
+
+	UPROPERTY()
+	TObjectPtr<UXRCoreReplicationGraph> Graph = nullptr;
+
+private:
+	FActorRepListRefView ReplicationActorList;
+};
@@ -0,0 +1,102 @@
+#include "XRCoreBenchmark.h"
+
+#include "Utilities/XRConstraintPoolSubsystem.h"
+
+#include "Components/SphereComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace XRConstraintPoolTests
+{
+	const FVector TestOrigin(0.0, 0.0, -100000.0);
+	const float SphereRadius = 10.0f;
+	// Grab offset of the mesh, the spheres overlap so only disabled collision lets the drive hold it there
+	const FVector GrabOffset(0.0, 0.0, 5.0);
+
+	void TickFrames(FXRCoreTestWorld& InTestWorld, int32 InNumFrames)
+	{
+		for (int32 Frame = 0; Frame < InNumFrames; ++Frame)
+		{
+			InTestWorld.Tick(1.0f / 60.0f);
+		}
+	}
+
+	USphereComponent* AddSphereBody(AActor* InActor, bool bInSimulatePhysics)
+	{
+		USphereComponent* Sphere = FXRCoreTestWorld::AddComponent<USphereComponent>(InActor);
+		Sphere->SetMobility(EComponentMobility::Movable);
+		Sphere->SetSphereRadius(SphereRadius);
+		Sphere->SetCollisionProfileName(bInSimulatePhysics ? UCollisionProfile::PhysicsActor_ProfileName : UCollisionProfile::BlockAll_ProfileName);
+		Sphere->SetEnableGravity(false);
+		Sphere->SetSimulatePhysics(bInSimulatePhysics);
+		return Sphere;
+	}
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Grab and release through the pool: the drive holds the mesh while grabbed, after release it is free and collides with the interactor again
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FXRConstraintPoolGrabReleaseTest, "XRCore.ConstraintPool.GrabRelease",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FXRConstraintPoolGrabReleaseTest::RunTest(const FString& Parameters)
+{
+	using namespace XRConstraintPoolTests;
+
+	FXRCoreTestWorld TestWorld;
+	UXRConstraintPoolSubsystem* ConstraintPool = TestWorld.GetWorld()->GetSubsystem<UXRConstraintPoolSubsystem>();
+	if (!TestNotNull(TEXT("Constraint pool exists in game worlds"), ConstraintPool))
+	{
+		return false;
+	}
+
+	// Kinematic interactor, like the hand collision of an XRInteractor
+	USphereComponent* Interactor = AddSphereBody(TestWorld.SpawnActor(TestOrigin), false);
+	USphereComponent* Mesh = AddSphereBody(TestWorld.SpawnActor(TestOrigin + GrabOffset), true);
+
+	FXRConstraintHandle Handle = ConstraintPool->AcquireConstraint(Interactor, Mesh);
+	if (!TestTrue(TEXT("Grab acquires a joint"), Handle.IsSet()))
+	{
+		return false;
+	}
+	TestEqual(TEXT("Joint in use while grabbed"), ConstraintPool->GetPoolStats().NumInUse, 1);
+
+	TickFrames(TestWorld, 30);
+	TestTrue(TEXT("Grabbed mesh is not pushed out of the interactor"), FVector::Dist(Mesh->GetComponentLocation(), Interactor->GetComponentLocation() + GrabOffset) < 1.0f);
+
+	Interactor->SetWorldLocation(TestOrigin + FVector(50.0, 0.0, 0.0));
+	TickFrames(TestWorld, 60);
+	TestTrue(TEXT("Grabbed mesh follows the interactor"), FVector::Dist(Mesh->GetComponentLocation(), Interactor->GetComponentLocation() + GrabOffset) < 5.0f);
+
+	ConstraintPool->ReleaseConstraint(Handle);
+	TestFalse(TEXT("Release resets the handle"), Handle.IsSet());
+	const FXRConstraintPoolStats ReleasedStats = ConstraintPool->GetPoolStats();
+	TestEqual(TEXT("No joint in use after release"), ReleasedStats.NumInUse, 0);
+	TestEqual(TEXT("Released joint stays idle in the pool"), ReleasedStats.NumConstraints, 1);
+
+	// With collision restored the overlapping spheres separate, with the drives off nothing pulls the mesh back
+	TickFrames(TestWorld, 60);
+	TestTrue(TEXT("Released mesh collides with the interactor again"), FVector::Dist(Mesh->GetComponentLocation(), Interactor->GetComponentLocation()) > SphereRadius * 1.5f);
+
+	const FVector ReleasedLocation = Mesh->GetComponentLocation();
+	Interactor->SetWorldLocation(TestOrigin - FVector(50.0, 0.0, 0.0));
+	TickFrames(TestWorld, 60);
+	TestTrue(TEXT("Released mesh no longer follows the interactor"), FVector::Dist(Mesh->GetComponentLocation(), Interactor->GetComponentLocation()) > 25.0f);
+	AddInfo(FString::Printf(TEXT("Released mesh moved %.2f cm after the interactor left"), FVector::Dist(Mesh->GetComponentLocation(), ReleasedLocation)));
+
+	// Grabbing the same pair again reuses the idle joint
+	Handle = ConstraintPool->AcquireConstraint(Interactor, Mesh);
+	TestTrue(TEXT("Grab again acquires a joint"), Handle.IsSet());
+	const FXRConstraintPoolStats RegrabStats = ConstraintPool->GetPoolStats();
+	TestEqual(TEXT("Grab again reuses the idle joint"), RegrabStats.NumReused, 1);
+	TestEqual(TEXT("Grab again creates no joint"), RegrabStats.NumCreated, 1);
+	ConstraintPool->ReleaseConstraint(Handle);
+
+	return true;
+}
+
+#endif
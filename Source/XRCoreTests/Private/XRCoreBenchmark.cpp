@@ -0,0 +1,98 @@
+#include "XRCoreBenchmark.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Timing
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+FXRBenchmarkResult FXRCoreBenchmark::Measure(const FString& InName, int32 InNumObjects, int32 InIterations, TFunctionRef<void()> InFunction)
+{
+	FXRBenchmarkResult Result;
+	Result.Name = InName;
+	Result.NumObjects = InNumObjects;
+	Result.NumIterations = FMath::Max(InIterations, 1);
+	Result.MinMs = TNumericLimits<double>::Max();
+
+	for (int32 Iteration = 0; Iteration < Result.NumIterations; ++Iteration)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		InFunction();
+		const double ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		Result.TotalMs += ElapsedMs;
+		Result.MinMs = FMath::Min(Result.MinMs, ElapsedMs);
+		Result.MaxMs = FMath::Max(Result.MaxMs, ElapsedMs);
+	}
+	Result.AverageMs = Result.TotalMs / Result.NumIterations;
+	return Result;
+}
+
+FString FXRCoreBenchmark::GetBenchmarkDirectory()
+{
+	return FPaths::ProjectSavedDir() / TEXT("XRCore") / TEXT("Benchmarks");
+}
+
+FString FXRCoreBenchmark::WriteCSV(const FString& InSuiteName, const TArray<FXRBenchmarkResult>& InResults)
+{
+	TArray<FString> Rows;
+	for (const FXRBenchmarkResult& Result : InResults)
+	{
+		Rows.Add(FString::Printf(TEXT("%s,%d,%d,%.6f,%.6f,%.6f,%.6f"), *Result.Name, Result.NumObjects, Result.NumIterations,
+			Result.AverageMs, Result.MinMs, Result.MaxMs, Result.TotalMs));
+	}
+	return WriteCSVRows(InSuiteName, TEXT("Name,NumObjects,NumIterations,AverageMs,MinMs,MaxMs,TotalMs"), Rows);
+}
+
+FString FXRCoreBenchmark::WriteCSVRows(const FString& InSuiteName, const FString& InHeader, const TArray<FString>& InRows)
+{
+	const FString CSV = InHeader + TEXT("\n") + FString::Join(InRows, TEXT("\n")) + TEXT("\n");
+
+	const FString Directory = GetBenchmarkDirectory();
+	IFileManager::Get().MakeDirectory(*Directory, true);
+	const FString FilePath = Directory / FString::Printf(TEXT("%s_%s.csv"), *InSuiteName, *FDateTime::Now().ToString());
+	return FFileHelper::SaveStringToFile(CSV, *FilePath) ? FilePath : FString();
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Test World
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+FXRCoreTestWorld::FXRCoreTestWorld()
+{
+	World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("XRCoreTestWorld"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+}
+
+FXRCoreTestWorld::~FXRCoreTestWorld()
+{
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+}
+
+void FXRCoreTestWorld::Tick(float InDeltaTime)
+{
+	World->Tick(LEVELTICK_All, InDeltaTime);
+}
+
+AActor* FXRCoreTestWorld::SpawnActor(const FVector& InLocation)
+{
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	SpawnParameters.ObjectFlags |= RF_Transient;
+	return World->SpawnActor<AActor>(AActor::StaticClass(), FTransform(InLocation), SpawnParameters);
+}
+
+FVector FXRCoreTestWorld::GetGridLocation(const FVector& InOrigin, int32 InIndex, int32 InCount, float InSpacing)
+{
+	const int32 Side = FMath::Max(FMath::CeilToInt(FMath::Sqrt(static_cast<float>(InCount))), 1);
+	const FVector Offset((InIndex % Side) - Side * 0.5f, (InIndex / Side) - Side * 0.5f, 0.0f);
+	return InOrigin + Offset * InSpacing;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+class UWorld;
+
+// Timing of one benchmark case, one row of a benchmark CSV
+struct FXRBenchmarkResult
+{
+	FString Name;
+	int32 NumObjects = 0;
+	int32 NumIterations = 0;
+	double AverageMs = 0.0;
+	double MinMs = 0.0;
+	double MaxMs = 0.0;
+	double TotalMs = 0.0;
+};
+
+// ================================================================================================================================================================
+// Timing and CSV output shared by the XRCore benchmark tests and xrcore.netbench, so runs of different builds can be compared
+// ================================================================================================================================================================
+class FXRCoreBenchmark
+{
+public:
+	/**
+	 * Call InFunction InIterations times and time every call.
+	 */
+	static FXRBenchmarkResult Measure(const FString& InName, int32 InNumObjects, int32 InIterations, TFunctionRef<void()> InFunction);
+
+	/**
+	 * Write results to Saved/XRCore/Benchmarks/<InSuiteName>_<Timestamp>.csv and return the file path, empty if writing failed.
+	 */
+	static FString WriteCSV(const FString& InSuiteName, const TArray<FXRBenchmarkResult>& InResults);
+
+	/**
+	 * Write a CSV with arbitrary columns to the benchmark directory, see WriteCSV.
+	 */
+	static FString WriteCSVRows(const FString& InSuiteName, const FString& InHeader, const TArray<FString>& InRows);
+
+	static FString GetBenchmarkDirectory();
+};
+
+// ================================================================================================================================================================
+// Game world for automation tests. XRCore subsystems only exist in game worlds, so tests can't use the editor world.
+// ================================================================================================================================================================
+class FXRCoreTestWorld
+{
+public:
+	FXRCoreTestWorld();
+	~FXRCoreTestWorld();
+
+	UWorld* GetWorld() const { return World; }
+
+	/**
+	 * Advance one frame: actors, components and tickable world subsystems.
+	 */
+	void Tick(float InDeltaTime = 1.0f / 90.0f);
+
+	/**
+	 * Spawn an empty transient actor.
+	 */
+	AActor* SpawnActor(const FVector& InLocation);
+
+	/**
+	 * Create and register a component. Scene components become the root of an actor without one, or attach to InParent.
+	 */
+	template<typename TComponent>
+	static TComponent* AddComponent(AActor* InActor, USceneComponent* InParent = nullptr)
+	{
+		TComponent* Component = NewObject<TComponent>(InActor);
+		if constexpr (TIsDerivedFrom<TComponent, USceneComponent>::IsDerived)
+		{
+			if (InParent)
+			{
+				Component->SetupAttachment(InParent);
+			}
+			else if (!InActor->GetRootComponent())
+			{
+				InActor->SetRootComponent(Component);
+			}
+		}
+		Component->RegisterComponent();
+		return Component;
+	}
+
+	// Objects spread on a grid of InSpacing around InOrigin
+	static FVector GetGridLocation(const FVector& InOrigin, int32 InIndex, int32 InCount, float InSpacing);
+
+private:
+	UWorld* World = nullptr;
+};
@@ -0,0 +1,306 @@
+#include "XRCoreBenchmark.h"
+
+#include "Connections/XRConnectorComponent.h"
+#include "Connections/XRConnectorSocket.h"
+#include "Core/XRCoreSettings.h"
+#include "Interactions/XRInteractionComponent.h"
+#include "Interactions/XRInteractorComponent.h"
+#include "Utilities/XRHighlightComponent.h"
+#include "Utilities/XRReplicatedPhysicsComponent.h"
+#include "Utilities/XRToolsUtilityFunctions.h"
+
+#include "Components/SphereComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// ================================================================================================================================================================
+// XRCore.Benchmark.*: timings of the XRCore hot paths at several object counts, logged and written to Saved/XRCore/Benchmarks.
+// Run with "Automation RunTests XRCore.Benchmark" (works with -nullrhi).
+// ================================================================================================================================================================
+namespace XRCoreBenchmark
+{
+	// Far away from the origin, in case a test world ever shares the level
+	const FVector BenchmarkOrigin(0.0, 0.0, -100000.0);
+	const int32 ObjectCounts[] = { 100, 500, 2000 };
+	const int32 NumIterations = 100;
+	// Each spawn iteration adds all objects to the world again
+	const int32 NumSpawnIterations = 5;
+
+	UStaticMesh* LoadBenchmarkMesh()
+	{
+		return LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	}
+
+	void ReportResults(FAutomationTestBase& InTest, const FString& InSuiteName, const TArray<FXRBenchmarkResult>& InResults)
+	{
+		for (const FXRBenchmarkResult& Result : InResults)
+		{
+			InTest.AddInfo(FString::Printf(TEXT("%-32s objects %6d  avg %8.4f ms  min %8.4f ms  max %8.4f ms"), *Result.Name, Result.NumObjects, Result.AverageMs, Result.MinMs, Result.MaxMs));
+		}
+		const FString FilePath = FXRCoreBenchmark::WriteCSV(InSuiteName, InResults);
+		InTest.TestFalse(TEXT("Benchmark CSV written"), FilePath.IsEmpty());
+		InTest.AddInfo(FilePath);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Interaction: interactables around one interactor that overlaps all of them
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FXRCoreInteractionBenchmarkTest, "XRCore.Benchmark.Interaction",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FXRCoreInteractionBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace XRCoreBenchmark;
+	TArray<FXRBenchmarkResult> Results;
+	for (const int32 NumObjects : ObjectCounts)
+	{
+		FXRCoreTestWorld TestWorld;
+		for (int32 Index = 0; Index < NumObjects; ++Index)
+		{
+			AActor* Interactable = TestWorld.SpawnActor(FXRCoreTestWorld::GetGridLocation(BenchmarkOrigin, Index, NumObjects, 2.0f));
+			USphereComponent* Collider = FXRCoreTestWorld::AddComponent<USphereComponent>(Interactable);
+			Collider->SetSphereRadius(5.0f);
+			FXRCoreTestWorld::AddComponent<UXRInteractionComponent>(Interactable, Collider);
+		}
+
+		AActor* InteractorActor = TestWorld.SpawnActor(BenchmarkOrigin);
+		UXRInteractorComponent* Interactor = FXRCoreTestWorld::AddComponent<UXRInteractorComponent>(InteractorActor);
+		Interactor->SetSphereRadius(FMath::Sqrt(static_cast<float>(NumObjects)) * 2.0f + 10.0f);
+		Interactor->UpdateOverlaps();
+
+		TArray<UXRInteractionComponent*> Overlapped;
+		Results.Add(FXRCoreBenchmark::Measure(TEXT("GetOverlappedXRInteractions"), NumObjects, NumIterations, [&]()
+		{
+			Overlapped = Interactor->GetOverlappedXRInteractions();
+		}));
+		TestTrue(TEXT("Interactor overlaps the interactables"), Overlapped.Num() > 0);
+
+		Results.Add(FXRCoreBenchmark::Measure(TEXT("GetXRInteractionByPriority"), Overlapped.Num(), NumIterations, [&]()
+		{
+			UXRToolsUtilityFunctions::GetXRInteractionByPriority(Overlapped, Interactor);
+		}));
+	}
+	ReportResults(*this, TEXT("Interaction"), Results);
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Connector: sockets around one connector that overlaps all of them
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FXRCoreConnectorBenchmarkTest, "XRCore.Benchmark.Connector",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FXRCoreConnectorBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace XRCoreBenchmark;
+	TArray<FXRBenchmarkResult> Results;
+	for (const int32 NumObjects : ObjectCounts)
+	{
+		FXRCoreTestWorld TestWorld;
+		AActor* ConnectorActor = TestWorld.SpawnActor(BenchmarkOrigin);
+		USphereComponent* ConnectorCollider = FXRCoreTestWorld::AddComponent<USphereComponent>(ConnectorActor);
+		ConnectorCollider->SetSphereRadius(FMath::Sqrt(static_cast<float>(NumObjects)) * 5.0f + 10.0f);
+		UXRConnectorComponent* Connector = FXRCoreTestWorld::AddComponent<UXRConnectorComponent>(ConnectorActor);
+
+		for (int32 Index = 0; Index < NumObjects; ++Index)
+		{
+			AActor* SocketActor = TestWorld.SpawnActor(FXRCoreTestWorld::GetGridLocation(BenchmarkOrigin, Index, NumObjects, 5.0f));
+			FXRCoreTestWorld::AddComponent<UXRConnectorSocket>(SocketActor);
+			SocketActor->UpdateOverlaps();
+		}
+
+		UXRConnectorSocket* ClosestSocket = nullptr;
+		Results.Add(FXRCoreBenchmark::Measure(TEXT("GetClosestOverlappedSocket"), NumObjects, NumIterations, [&]()
+		{
+			ClosestSocket = Connector->GetClosestOverlappedSocket();
+		}));
+		TestNotNull(TEXT("Connector finds a socket"), ClosestSocket);
+
+		Results.Add(FXRCoreBenchmark::Measure(TEXT("HologramShowHide"), NumObjects, NumIterations, [&]()
+		{
+			Connector->ShowAllAvailableHolograms();
+			Connector->HideAllHolograms();
+		}));
+	}
+	ReportResults(*this, TEXT("Connector"), Results);
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Highlight: one fade in or out per highlight per iteration, then one frame worth of timeline ticks
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FXRCoreHighlightBenchmarkTest, "XRCore.Benchmark.Highlight",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FXRCoreHighlightBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace XRCoreBenchmark;
+	UStaticMesh* Mesh = LoadBenchmarkMesh();
+	TArray<FXRBenchmarkResult> Results;
+	for (const int32 NumObjects : ObjectCounts)
+	{
+		FXRCoreTestWorld TestWorld;
+		TArray<UXRHighlightComponent*> Highlights;
+		for (int32 Index = 0; Index < NumObjects; ++Index)
+		{
+			AActor* HighlightActor = TestWorld.SpawnActor(FXRCoreTestWorld::GetGridLocation(BenchmarkOrigin, Index, NumObjects, 200.0f));
+			UStaticMeshComponent* MeshComponent = FXRCoreTestWorld::AddComponent<UStaticMeshComponent>(HighlightActor);
+			MeshComponent->SetStaticMesh(Mesh);
+			MeshComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+			Highlights.Add(FXRCoreTestWorld::AddComponent<UXRHighlightComponent>(HighlightActor));
+		}
+
+		bool bFadeIn = true;
+		Results.Add(FXRCoreBenchmark::Measure(TEXT("HighlightFade"), NumObjects, NumIterations, [&]()
+		{
+			for (UXRHighlightComponent* Highlight : Highlights)
+			{
+				Highlight->FadeXRHighlight(bFadeIn);
+			}
+			bFadeIn = !bFadeIn;
+		}));
+		Results.Add(FXRCoreBenchmark::Measure(TEXT("HighlightTick"), NumObjects, NumIterations, [&]()
+		{
+			for (UXRHighlightComponent* Highlight : Highlights)
+			{
+				Highlight->TickComponent(1.0f / 90.0f, LEVELTICK_All, nullptr);
+			}
+		}));
+	}
+	ReportResults(*this, TEXT("Highlight"), Results);
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Highlight creation: spawning interactables with bLazyHighlightCreation on and off, and the highlight components they leave behind
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FXRCoreHighlightCreationBenchmarkTest, "XRCore.Benchmark.HighlightCreation",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FXRCoreHighlightCreationBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace XRCoreBenchmark;
+	UStaticMesh* Mesh = LoadBenchmarkMesh();
+	UXRCoreSettings* Settings = GetMutableDefault<UXRCoreSettings>();
+	const bool bPreviousLazyHighlightCreation = Settings->bLazyHighlightCreation;
+	TArray<FXRBenchmarkResult> Results;
+	for (const int32 NumObjects : ObjectCounts)
+	{
+		for (const bool bLazy : { false, true })
+		{
+			Settings->bLazyHighlightCreation = bLazy;
+			FXRCoreTestWorld TestWorld;
+			TArray<AActor*> Interactables;
+			Results.Add(FXRCoreBenchmark::Measure(bLazy ? TEXT("SpawnInteractablesLazyHighlight") : TEXT("SpawnInteractablesEagerHighlight"), NumObjects, NumSpawnIterations, [&]()
+			{
+				for (int32 Index = 0; Index < NumObjects; ++Index)
+				{
+					AActor* Interactable = TestWorld.SpawnActor(FXRCoreTestWorld::GetGridLocation(BenchmarkOrigin, Index, NumObjects, 200.0f));
+					UStaticMeshComponent* MeshComponent = FXRCoreTestWorld::AddComponent<UStaticMeshComponent>(Interactable);
+					MeshComponent->SetStaticMesh(Mesh);
+					MeshComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+					FXRCoreTestWorld::AddComponent<UXRInteractionComponent>(Interactable, MeshComponent);
+					Interactables.Add(Interactable);
+				}
+			}));
+
+			int32 NumHighlights = 0;
+			int32 NumComponents = 0;
+			int64 HighlightBytes = 0;
+			for (AActor* Interactable : Interactables)
+			{
+				NumComponents += Interactable->GetComponents().Num();
+				if (UXRHighlightComponent* Highlight = Interactable->FindComponentByClass<UXRHighlightComponent>())
+				{
+					NumHighlights++;
+					HighlightBytes += Highlight->GetClass()->GetStructureSize() + Highlight->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+				}
+			}
+			TestEqual(TEXT("Highlight components match bLazyHighlightCreation"), NumHighlights, bLazy ? 0 : Interactables.Num());
+			AddInfo(FString::Printf(TEXT("%-32s objects %6d  highlights %6d  components per actor %5.2f  highlight bytes %10lld"),
+				bLazy ? TEXT("LazyHighlight") : TEXT("EagerHighlight"), Interactables.Num(), NumHighlights,
+				Interactables.Num() > 0 ? static_cast<float>(NumComponents) / Interactables.Num() : 0.0f, HighlightBytes));
+		}
+	}
+	Settings->bLazyHighlightCreation = bPreviousLazyHighlightCreation;
+	ReportResults(*this, TEXT("HighlightCreation"), Results);
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Physics: ticks of replicated physics props at rest, moving, and on clients interpolating towards their snapshot
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FXRCorePhysicsBenchmarkTest, "XRCore.Benchmark.Physics",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FXRCorePhysicsBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace XRCoreBenchmark;
+	UStaticMesh* Mesh = LoadBenchmarkMesh();
+	TArray<FXRBenchmarkResult> Results;
+	for (const int32 NumObjects : ObjectCounts)
+	{
+		FXRCoreTestWorld TestWorld;
+		TArray<UActorComponent*> PhysicsComponents;
+		TArray<UStaticMeshComponent*> PhysicsMeshes;
+		TArray<UActorComponent*> ClientPhysicsComponents;
+		for (int32 Index = 0; Index < NumObjects; ++Index)
+		{
+			AActor* PhysicsActor = TestWorld.SpawnActor(FXRCoreTestWorld::GetGridLocation(BenchmarkOrigin, Index, NumObjects, 200.0f));
+			UStaticMeshComponent* MeshComponent = FXRCoreTestWorld::AddComponent<UStaticMeshComponent>(PhysicsActor);
+			MeshComponent->SetStaticMesh(Mesh);
+			MeshComponent->SetMobility(EComponentMobility::Movable);
+			PhysicsMeshes.Add(MeshComponent);
+			PhysicsComponents.Add(FXRCoreTestWorld::AddComponent<UXRReplicatedPhysicsComponent>(PhysicsActor));
+
+			// Simulated proxies run ClientTick, their snapshot stays at the origin so they keep interpolating
+			AActor* ClientActor = TestWorld.SpawnActor(FXRCoreTestWorld::GetGridLocation(BenchmarkOrigin + FVector(0.0, 0.0, 1000.0), Index, NumObjects, 200.0f));
+			ClientActor->SetRole(ROLE_SimulatedProxy);
+			UStaticMeshComponent* ClientMeshComponent = FXRCoreTestWorld::AddComponent<UStaticMeshComponent>(ClientActor);
+			ClientMeshComponent->SetStaticMesh(Mesh);
+			ClientMeshComponent->SetMobility(EComponentMobility::Movable);
+			ClientPhysicsComponents.Add(FXRCoreTestWorld::AddComponent<UXRReplicatedPhysicsComponent>(ClientActor));
+		}
+
+		Results.Add(FXRCoreBenchmark::Measure(TEXT("ReplicatedPhysicsTick"), NumObjects, NumIterations, [&]()
+		{
+			for (UActorComponent* PhysicsComponent : PhysicsComponents)
+			{
+				PhysicsComponent->TickComponent(1.0f / 90.0f, LEVELTICK_All, nullptr);
+			}
+		}));
+
+		// The world is not ticked, so the set velocity is kept and every tick takes the moving path with its snapshots
+		for (UStaticMeshComponent* MeshComponent : PhysicsMeshes)
+		{
+			MeshComponent->SetSimulatePhysics(true);
+			MeshComponent->SetPhysicsLinearVelocity(FVector(100.0, 0.0, 0.0));
+		}
+		TestTrue(TEXT("Physics props are moving"), PhysicsMeshes[0]->GetOwner()->GetVelocity().Size() > 1.0);
+		Results.Add(FXRCoreBenchmark::Measure(TEXT("ReplicatedPhysicsTickMoving"), NumObjects, NumIterations, [&]()
+		{
+			for (UActorComponent* PhysicsComponent : PhysicsComponents)
+			{
+				PhysicsComponent->TickComponent(1.0f / 90.0f, LEVELTICK_All, nullptr);
+			}
+		}));
+
+		Results.Add(FXRCoreBenchmark::Measure(TEXT("ReplicatedPhysicsClientTick"), NumObjects, NumIterations, [&]()
+		{
+			for (UActorComponent* PhysicsComponent : ClientPhysicsComponents)
+			{
+				PhysicsComponent->TickComponent(1.0f / 90.0f, LEVELTICK_All, nullptr);
+			}
+		}));
+	}
+	ReportResults(*this, TEXT("Physics"), Results);
+	return true;
+}
+
+#endif
@@ -0,0 +1,446 @@
+#include "XRCoreBenchmark.h"
+#include "Utilities/XRCoreNetStats.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include "Connections/XRConnectorComponent.h"
+#include "Core/XRCoreHand.h"
+#include "Interactions/XRInteractorComponent.h"
+#include "Utilities/XRReplicatedPhysicsComponent.h"
+
+#include "Components/MeshComponent.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "TimerManager.h"
+
+// ================================================================================================================================================================
+// xrcore.netbench: scripted grabs, throws and connects on a listen server, reporting XRCore traffic per feature.
+// Run in PIE as listen server with N clients in one process, so snapshot latency can be traced into the client worlds.
+// A console command rather than an automation test, as it needs the multi-client PIE session to measure anything.
+// By default every dormancy setting gets a scripted pass and an idle pass, in which the props are left at rest after a warm-up that is not measured.
+// Each pass reports XRCore bytes per feature, the net driver rates and the time the server world spent per frame.
+// ================================================================================================================================================================
+namespace XRCoreNetBenchmark
+{
+	// Traffic of one pass with net dormancy on or off
+	struct FNetBenchmarkPhase
+	{
+		bool bNetDormancy = true;
+		// No scripted actions, only measured after the warm-up
+		bool bIdle = false;
+		int32 NumPhysicsActors = 0;
+		int32 NumRestingPhysicsActors = 0;
+		double Duration = 0.0;
+		double DriverOutRate = 0.0;
+		double DriverInRate = 0.0;
+		// Server world, from tick dispatch to the end of the replication flush
+		double ServerTickMs = 0.0;
+		double ServerTickShare = 0.0;
+		double AverageSnapshotLatency = 0.0;
+		double MaxSnapshotLatency = 0.0;
+		TArray<FXRNetFeatureStats> FeatureStats;
+	};
+
+	struct FNetBenchmarkPhaseSetup
+	{
+		bool bNetDormancy = true;
+		bool bIdle = false;
+	};
+
+	struct FNetBenchmarkRun
+	{
+		TWeakObjectPtr<UWorld> World = nullptr;
+		FTimerHandle ScriptTimer;
+		FTimerHandle WarmupTimer;
+		FTimerHandle FinishTimer;
+		float PhaseSeconds = 10.0f;
+		float WarmupSeconds = 5.0f;
+		bool bMeasuring = false;
+		double StartTime = 0.0;
+		uint64 StartOutBytes = 0;
+		uint64 StartInBytes = 0;
+		double ServerTickStartTime = 0.0;
+		double ServerTickTime = 0.0;
+		int64 NumServerTicks = 0;
+		FDelegateHandle TickDispatchHandle;
+		FDelegateHandle PostTickFlushHandle;
+		float PktLag = 0.0f;
+		float PktLoss = 0.0f;
+		FString PreviousPktLag;
+		FString PreviousPktLoss;
+		bool bScriptStep = false;
+		// Passes still to run, and the results of the finished ones
+		TArray<FNetBenchmarkPhaseSetup> PendingPhases;
+		TArray<FNetBenchmarkPhase> Phases;
+		// bEnableNetDormancy of the physics components before the run, restored afterwards
+		TArray<TPair<TWeakObjectPtr<UXRReplicatedPhysicsComponent>, bool>> PreviousNetDormancy;
+	};
+
+	TSharedPtr<FNetBenchmarkRun> ActiveRun;
+
+	void OnPhaseElapsed();
+
+	void SetConsoleVariable(const TCHAR* InName, const FString& InValue, FString* OutPreviousValue = nullptr)
+	{
+		if (IConsoleVariable* Variable = IConsoleManager::Get().FindConsoleVariable(InName))
+		{
+			if (OutPreviousValue)
+			{
+				*OutPreviousValue = Variable->GetString();
+			}
+			Variable->Set(*InValue, ECVF_SetByConsole);
+		}
+	}
+
+	// Alternates between acting and releasing, so every step produces start and end traffic
+	void RunScriptStep(FNetBenchmarkRun& InRun)
+	{
+		UWorld* World = InRun.World.Get();
+		if (!World || (InRun.Phases.Num() > 0 && InRun.Phases.Last().bIdle))
+		{
+			return;
+		}
+		InRun.bScriptStep = !InRun.bScriptStep;
+
+		// Grabs: every hand grabs whatever it overlaps, then lets go
+		for (TActorIterator<AXRCoreHand> It(World); It; ++It)
+		{
+			if (UXRInteractorComponent* Interactor = IXRCoreHandInterface::Execute_GetXRInteractor(*It))
+			{
+				if (InRun.bScriptStep)
+				{
+					Interactor->StartXRInteractionByPriority();
+				}
+				else
+				{
+					Interactor->StopAllXRInteractions();
+				}
+			}
+		}
+
+		for (TActorIterator<AActor> It(World); It; ++It)
+		{
+			// Throws: random impulse on every resting prop
+			if (UXRReplicatedPhysicsComponent* PhysicsComponent = It->FindComponentByClass<UXRReplicatedPhysicsComponent>())
+			{
+				if (InRun.bScriptStep && !PhysicsComponent->GetInteractedWith())
+				{
+					for (UMeshComponent* Mesh : PhysicsComponent->GetRegisteredMeshComponents())
+					{
+						if (Mesh && Mesh->IsSimulatingPhysics())
+						{
+							Mesh->AddImpulse(FMath::VRand() * 300.0f + FVector(0.0f, 0.0f, 300.0f), NAME_None, true);
+						}
+					}
+				}
+			}
+			// Connects: connect to the closest overlapped socket, then disconnect
+			if (UXRConnectorComponent* Connector = It->FindComponentByClass<UXRConnectorComponent>())
+			{
+				if (InRun.bScriptStep)
+				{
+					Connector->Server_ConnectToClosestOverlappedSocket();
+				}
+				else
+				{
+					Connector->Server_DisconnectFromSocket();
+				}
+			}
+		}
+	}
+
+	void SetNetDormancyEnabled(FNetBenchmarkRun& InRun, bool bInEnabled)
+	{
+		UWorld* World = InRun.World.Get();
+		if (!World)
+		{
+			return;
+		}
+		for (TActorIterator<AActor> It(World); It; ++It)
+		{
+			UXRReplicatedPhysicsComponent* PhysicsComponent = It->FindComponentByClass<UXRReplicatedPhysicsComponent>();
+			if (!PhysicsComponent)
+			{
+				continue;
+			}
+			if (!InRun.PreviousNetDormancy.ContainsByPredicate([PhysicsComponent](const TPair<TWeakObjectPtr<UXRReplicatedPhysicsComponent>, bool>& Entry) { return Entry.Key == PhysicsComponent; }))
+			{
+				InRun.PreviousNetDormancy.Emplace(PhysicsComponent, PhysicsComponent->bEnableNetDormancy);
+			}
+			PhysicsComponent->bEnableNetDormancy = bInEnabled;
+			if (!bInEnabled)
+			{
+				PhysicsComponent->WakeNetDormancy();
+			}
+		}
+	}
+
+	// Server world frame time, the clients of a PIE session tick their own worlds in between
+	void OnServerTickDispatch(float InDeltaSeconds)
+	{
+		if (ActiveRun.IsValid())
+		{
+			ActiveRun->ServerTickStartTime = FPlatformTime::Seconds();
+		}
+	}
+
+	void OnServerPostTickFlush()
+	{
+		if (ActiveRun.IsValid() && ActiveRun->bMeasuring && ActiveRun->ServerTickStartTime > 0.0)
+		{
+			ActiveRun->ServerTickTime += FPlatformTime::Seconds() - ActiveRun->ServerTickStartTime;
+			ActiveRun->NumServerTicks++;
+		}
+	}
+
+	void BeginMeasurement(FNetBenchmarkRun& InRun)
+	{
+		UWorld* World = InRun.World.Get();
+		if (!World || InRun.Phases.Num() == 0)
+		{
+			return;
+		}
+		FNetBenchmarkPhase& Phase = InRun.Phases.Last();
+		for (TActorIterator<AActor> It(World); It; ++It)
+		{
+			const UXRReplicatedPhysicsComponent* PhysicsComponent = It->FindComponentByClass<UXRReplicatedPhysicsComponent>();
+			if (!PhysicsComponent)
+			{
+				continue;
+			}
+			Phase.NumPhysicsActors++;
+			const bool bAwake = PhysicsComponent->GetRegisteredMeshComponents().ContainsByPredicate([](const UMeshComponent* Mesh)
+			{
+				return Mesh && Mesh->IsSimulatingPhysics() && Mesh->RigidBodyIsAwake();
+			});
+			Phase.NumRestingPhysicsActors += bAwake ? 0 : 1;
+		}
+
+		FXRCoreNetStats::Reset();
+		InRun.bMeasuring = true;
+		InRun.ServerTickTime = 0.0;
+		InRun.NumServerTicks = 0;
+		InRun.StartTime = FPlatformTime::Seconds();
+		InRun.StartOutBytes = World->GetNetDriver()->OutTotalBytes;
+		InRun.StartInBytes = World->GetNetDriver()->InTotalBytes;
+		World->GetTimerManager().SetTimer(InRun.FinishTimer, FTimerDelegate::CreateStatic(&OnPhaseElapsed), InRun.PhaseSeconds, false);
+	}
+
+	// Idle passes release what the script holds and let the props settle and go dormant before measuring
+	void StartPhase(FNetBenchmarkRun& InRun)
+	{
+		UWorld* World = InRun.World.Get();
+		if (!World || InRun.PendingPhases.Num() == 0)
+		{
+			return;
+		}
+		const FNetBenchmarkPhaseSetup Setup = InRun.PendingPhases[0];
+		InRun.PendingPhases.RemoveAt(0);
+		if (Setup.bIdle && InRun.bScriptStep)
+		{
+			RunScriptStep(InRun);
+		}
+
+		FNetBenchmarkPhase& Phase = InRun.Phases.AddDefaulted_GetRef();
+		Phase.bNetDormancy = Setup.bNetDormancy;
+		Phase.bIdle = Setup.bIdle;
+		SetNetDormancyEnabled(InRun, Phase.bNetDormancy);
+
+		if (Setup.bIdle && InRun.WarmupSeconds > 0.0f)
+		{
+			World->GetTimerManager().SetTimer(InRun.WarmupTimer, FTimerDelegate::CreateLambda([]()
+			{
+				if (ActiveRun.IsValid())
+				{
+					BeginMeasurement(*ActiveRun);
+				}
+			}), InRun.WarmupSeconds, false);
+			return;
+		}
+		BeginMeasurement(InRun);
+	}
+
+	void EndPhase(FNetBenchmarkRun& InRun)
+	{
+		const UWorld* World = InRun.World.Get();
+		if (!World || InRun.Phases.Num() == 0)
+		{
+			return;
+		}
+		InRun.bMeasuring = false;
+		FNetBenchmarkPhase& Phase = InRun.Phases.Last();
+		Phase.Duration = FMath::Max(FPlatformTime::Seconds() - InRun.StartTime, KINDA_SMALL_NUMBER);
+		const UNetDriver* NetDriver = World->GetNetDriver();
+		Phase.DriverOutRate = NetDriver ? (NetDriver->OutTotalBytes - InRun.StartOutBytes) / Phase.Duration : 0.0;
+		Phase.DriverInRate = NetDriver ? (NetDriver->InTotalBytes - InRun.StartInBytes) / Phase.Duration : 0.0;
+		Phase.ServerTickMs = InRun.NumServerTicks > 0 ? InRun.ServerTickTime / InRun.NumServerTicks * 1000.0 : 0.0;
+		Phase.ServerTickShare = InRun.ServerTickTime / Phase.Duration;
+		Phase.AverageSnapshotLatency = FXRCoreNetStats::GetAverageSnapshotLatency();
+		Phase.MaxSnapshotLatency = FXRCoreNetStats::GetMaxSnapshotLatency();
+		for (int32 FeatureIndex = 0; FeatureIndex < static_cast<int32>(EXRNetFeature::Num); ++FeatureIndex)
+		{
+			Phase.FeatureStats.Add(FXRCoreNetStats::GetFeatureStats(static_cast<EXRNetFeature>(FeatureIndex)));
+		}
+	}
+
+	void FinishRun(FOutputDevice* InAr)
+	{
+		if (!ActiveRun.IsValid())
+		{
+			return;
+		}
+		TSharedPtr<FNetBenchmarkRun> Run = ActiveRun;
+		ActiveRun.Reset();
+		FXRCoreNetStats::SetTrackingEnabled(false);
+
+		SetConsoleVariable(TEXT("NetEmulation.PktLag"), Run->PreviousPktLag);
+		SetConsoleVariable(TEXT("NetEmulation.PktLoss"), Run->PreviousPktLoss);
+		for (const TPair<TWeakObjectPtr<UXRReplicatedPhysicsComponent>, bool>& Entry : Run->PreviousNetDormancy)
+		{
+			if (UXRReplicatedPhysicsComponent* PhysicsComponent = Entry.Key.Get())
+			{
+				PhysicsComponent->bEnableNetDormancy = Entry.Value;
+			}
+		}
+
+		UWorld* World = Run->World.Get();
+		if (!World)
+		{
+			return;
+		}
+		World->GetTimerManager().ClearTimer(Run->ScriptTimer);
+		World->GetTimerManager().ClearTimer(Run->WarmupTimer);
+		World->GetTimerManager().ClearTimer(Run->FinishTimer);
+		World->OnTickDispatch().Remove(Run->TickDispatchHandle);
+		World->OnPostTickFlush().Remove(Run->PostTickFlushHandle);
+
+		const UNetDriver* NetDriver = World->GetNetDriver();
+		const int32 NumClients = NetDriver ? NetDriver->ClientConnections.Num() : 0;
+
+		TArray<FString> Rows;
+		FOutputDevice& Ar = InAr ? *InAr : *GLog;
+		Ar.Logf(TEXT("xrcore.netbench: %.1f s per pass, %.1f s idle warm-up, %d clients, lag %.0f ms, loss %.0f %%"), Run->PhaseSeconds, Run->WarmupSeconds, NumClients, Run->PktLag, Run->PktLoss);
+		for (const FNetBenchmarkPhase& Phase : Run->Phases)
+		{
+			const TCHAR* DormancyName = Phase.bNetDormancy ? TEXT("On") : TEXT("Off");
+			const TCHAR* PassName = Phase.bIdle ? TEXT("Idle") : TEXT("Scripted");
+			Ar.Logf(TEXT("%s, net dormancy %s, %d of %d physics actors resting at the start"), PassName, DormancyName, Phase.NumRestingPhysicsActors, Phase.NumPhysicsActors);
+			for (int32 FeatureIndex = 0; FeatureIndex < Phase.FeatureStats.Num(); ++FeatureIndex)
+			{
+				const TCHAR* FeatureName = FXRCoreNetStats::GetFeatureName(static_cast<EXRNetFeature>(FeatureIndex));
+				const FXRNetFeatureStats& Stats = Phase.FeatureStats[FeatureIndex];
+				// Object references are counted at an assumed net GUID size, the bytes of those features are estimates
+				const bool bEstimated = Stats.NumEstimatedMessages > 0;
+				Ar.Logf(TEXT("  %-22s %8.1f msg/s  %10.1f B/s%s"), FeatureName, Stats.NumMessages / Phase.Duration, Stats.NumBytes / Phase.Duration, bEstimated ? TEXT(" (estimated)") : TEXT(""));
+				Rows.Add(FString::Printf(TEXT("%s,%s,%s,%.3f,%.3f,%d"), DormancyName, PassName, FeatureName, Stats.NumMessages / Phase.Duration, Stats.NumBytes / Phase.Duration, bEstimated ? 1 : 0));
+			}
+			Rows.Add(FString::Printf(TEXT("%s,%s,NetDriverOut,,%.3f,0"), DormancyName, PassName, Phase.DriverOutRate));
+			Rows.Add(FString::Printf(TEXT("%s,%s,NetDriverIn,,%.3f,0"), DormancyName, PassName, Phase.DriverInRate));
+			Rows.Add(FString::Printf(TEXT("%s,%s,ServerTickMs,,%.3f,0"), DormancyName, PassName, Phase.ServerTickMs));
+			Rows.Add(FString::Printf(TEXT("%s,%s,SnapshotLatencyAvgMs,,%.3f,0"), DormancyName, PassName, Phase.AverageSnapshotLatency * 1000.0));
+			Rows.Add(FString::Printf(TEXT("%s,%s,SnapshotLatencyMaxMs,,%.3f,0"), DormancyName, PassName, Phase.MaxSnapshotLatency * 1000.0));
+
+			Ar.Logf(TEXT("  NetDriver out %.1f B/s, in %.1f B/s (whole driver, with packet and bunch headers)"), Phase.DriverOutRate, Phase.DriverInRate);
+			Ar.Logf(TEXT("  Server world tick %.3f ms per frame, %.1f %% of the pass"), Phase.ServerTickMs, Phase.ServerTickShare * 100.0);
+			Ar.Logf(TEXT("  Snapshot to visual latency avg %.1f ms, max %.1f ms"), Phase.AverageSnapshotLatency * 1000.0, Phase.MaxSnapshotLatency * 1000.0);
+		}
+
+		for (const bool bIdle : { false, true })
+		{
+			const FNetBenchmarkPhase* DormantPhase = Run->Phases.FindByPredicate([bIdle](const FNetBenchmarkPhase& Phase) { return Phase.bNetDormancy && Phase.bIdle == bIdle; });
+			const FNetBenchmarkPhase* AwakePhase = Run->Phases.FindByPredicate([bIdle](const FNetBenchmarkPhase& Phase) { return !Phase.bNetDormancy && Phase.bIdle == bIdle; });
+			if (DormantPhase && AwakePhase && AwakePhase->DriverOutRate > 0.0)
+			{
+				Ar.Logf(TEXT("%s: net dormancy saves %.1f B/s out (%.0f %%), server tick %.3f ms vs %.3f ms per frame"), bIdle ? TEXT("Idle") : TEXT("Scripted"),
+					AwakePhase->DriverOutRate - DormantPhase->DriverOutRate, (1.0 - DormantPhase->DriverOutRate / AwakePhase->DriverOutRate) * 100.0,
+					DormantPhase->ServerTickMs, AwakePhase->ServerTickMs);
+			}
+		}
+
+		const FString FilePath = FXRCoreBenchmark::WriteCSVRows(FString::Printf(TEXT("Net_%dClients_%.0fms_%.0fpct"), NumClients, Run->PktLag, Run->PktLoss),
+			TEXT("NetDormancy,Pass,Feature,MessagesPerSecond,BytesPerSecond,BytesEstimated"), Rows);
+		Ar.Logf(TEXT("xrcore.netbench: %s"), FilePath.IsEmpty() ? TEXT("failed to write results") : *FilePath);
+	}
+
+	// Next pass, or the report after the last one
+	void OnPhaseElapsed()
+	{
+		if (!ActiveRun.IsValid())
+		{
+			return;
+		}
+		EndPhase(*ActiveRun);
+		UWorld* World = ActiveRun->World.Get();
+		if (!World || ActiveRun->PendingPhases.Num() == 0)
+		{
+			FinishRun(nullptr);
+			return;
+		}
+		StartPhase(*ActiveRun);
+	}
+
+	// Args: [Seconds per pass=10] [PktLag ms=0] [PktLoss percent=0] [ScriptInterval s=1] [Dormancy on|off|both=both] [Idle warm-up s=5]
+	FAutoConsoleCommandWithWorldArgsAndOutputDevice NetBenchCommand(
+		TEXT("xrcore.netbench"),
+		TEXT("Script grabs, throws and connects on the server, then leave the props idle, and report XRCore traffic per feature and server tick time. Args: [Seconds] [PktLag ms] [PktLoss %] [ScriptInterval s] [Dormancy on|off|both] [Idle warm-up s]"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+		{
+			if (!World || !World->GetNetDriver() || !World->GetNetDriver()->IsServer())
+			{
+				Ar.Log(TEXT("xrcore.netbench: run on a listen server, e.g. PIE as Listen Server with clients in one process."));
+				return;
+			}
+			if (ActiveRun.IsValid())
+			{
+				Ar.Log(TEXT("xrcore.netbench: a run is already in progress."));
+				return;
+			}
+
+			const float Seconds = Args.Num() > 0 ? FMath::Max(FCString::Atof(*Args[0]), 1.0f) : 10.0f;
+			const float ScriptInterval = Args.Num() > 3 ? FMath::Max(FCString::Atof(*Args[3]), 0.1f) : 1.0f;
+
+			ActiveRun = MakeShared<FNetBenchmarkRun>();
+			ActiveRun->World = World;
+			ActiveRun->PhaseSeconds = Seconds;
+			ActiveRun->WarmupSeconds = Args.Num() > 5 ? FMath::Max(FCString::Atof(*Args[5]), 0.0f) : 5.0f;
+			const FString DormancyArg = Args.Num() > 4 ? Args[4] : TEXT("both");
+			TArray<bool> DormancySettings;
+			if (DormancyArg == TEXT("on") || DormancyArg == TEXT("1") || DormancyArg == TEXT("both"))
+			{
+				DormancySettings.Add(true);
+			}
+			if (DormancyArg != TEXT("on") && DormancyArg != TEXT("1"))
+			{
+				DormancySettings.Add(false);
+			}
+			for (const bool bNetDormancy : DormancySettings)
+			{
+				ActiveRun->PendingPhases.Add({ bNetDormancy, false });
+				ActiveRun->PendingPhases.Add({ bNetDormancy, true });
+			}
+			ActiveRun->PktLag = Args.Num() > 1 ? FMath::Max(FCString::Atof(*Args[1]), 0.0f) : 0.0f;
+			ActiveRun->PktLoss = Args.Num() > 2 ? FMath::Clamp(FCString::Atof(*Args[2]), 0.0f, 100.0f) : 0.0f;
+			SetConsoleVariable(TEXT("NetEmulation.PktLag"), FString::SanitizeFloat(ActiveRun->PktLag), &ActiveRun->PreviousPktLag);
+			SetConsoleVariable(TEXT("NetEmulation.PktLoss"), FString::SanitizeFloat(ActiveRun->PktLoss), &ActiveRun->PreviousPktLoss);
+
+			FXRCoreNetStats::SetTrackingEnabled(true);
+			ActiveRun->TickDispatchHandle = World->OnTickDispatch().AddStatic(&OnServerTickDispatch);
+			ActiveRun->PostTickFlushHandle = World->OnPostTickFlush().AddStatic(&OnServerPostTickFlush);
+			StartPhase(*ActiveRun);
+
+			World->GetTimerManager().SetTimer(ActiveRun->ScriptTimer, FTimerDelegate::CreateLambda([]()
+			{
+				if (ActiveRun.IsValid())
+				{
+					RunScriptStep(*ActiveRun);
+				}
+			}), ScriptInterval, true);
+
+			Ar.Logf(TEXT("xrcore.netbench: running %d pass(es) of %.1f s"), ActiveRun->Phases.Num() + ActiveRun->PendingPhases.Num(), Seconds);
+		}));
+}
+
+#endif
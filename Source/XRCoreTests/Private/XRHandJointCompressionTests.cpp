@@ -0,0 +1,200 @@
+#include "Utilities/XRHandJointCompression.h"
+
+#include "Misc/AutomationTest.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace XRHandJointCompressionTests
+{
+	const int32 NumFrames = 200;
+	const float FrameInterval = 0.05f;
+
+	// Fingers curling at different rates on top of a bent rest pose, like a hand opening and closing
+	void MakeHandFrame(int32 InFrame, const TArray<FQuat>& InRestPose, TArray<FQuat>& OutLocalRotations)
+	{
+		OutLocalRotations.SetNum(XRHandJoints::NumJoints);
+		const float Time = InFrame * FrameInterval;
+		for (int32 Joint = 0; Joint < XRHandJoints::NumJoints; Joint++)
+		{
+			// Palm and wrist (0, 1) hold still, so delta coding has something to skip
+			const float Curl = Joint < 2 ? 0.0f : 0.6f * FMath::Sin(Time * (1.0f + Joint * 0.1f));
+			const float Spread = Joint < 2 ? 0.0f : 0.1f * FMath::Cos(Time * 0.7f + Joint);
+			OutLocalRotations[Joint] = InRestPose[Joint] * FQuat(FVector::RightVector, Curl) * FQuat(FVector::UpVector, Spread);
+		}
+	}
+
+	void MakeRestPose(TArray<FQuat>& OutRestPose)
+	{
+		OutRestPose.SetNum(XRHandJoints::NumJoints);
+		for (int32 Joint = 0; Joint < XRHandJoints::NumJoints; Joint++)
+		{
+			OutRestPose[Joint] = FRotator(Joint * 3.0f, Joint * -2.0f, Joint * 5.0f).Quaternion();
+		}
+	}
+
+	// Serialize through the net serializer, so the measured size is what goes on the wire
+	bool RoundTrip(FXRHandJointPacket InPacket, FXRHandJointPacket& OutPacket, int64& OutNumBits)
+	{
+		FBitWriter Writer(0, true);
+		bool bSuccess = false;
+		InPacket.NetSerialize(Writer, nullptr, bSuccess);
+		OutNumBits = Writer.GetNumBits();
+
+		FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+		bool bReadSuccess = false;
+		OutPacket.NetSerialize(Reader, nullptr, bReadSuccess);
+		return bSuccess && bReadSuccess && !Reader.IsError();
+	}
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Bytes per frame and reconstruction error of full and delta coded frames at several precisions
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FXRHandJointCodecTest, "XRCore.HandJoints.Codec",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FXRHandJointCodecTest::RunTest(const FString& Parameters)
+{
+	using namespace XRHandJointCompressionTests;
+
+	TArray<FQuat> RestPose;
+	MakeRestPose(RestPose);
+
+	const int32 Precisions[] = { 8, 10, 12 };
+	for (const int32 Precision : Precisions)
+	{
+		int64 FullBits = 0;
+		int64 DeltaBits = 0;
+		float MaxError = 0.0f;
+
+		TArray<FXRQuantizedJointRotation> PreviousFrame;
+		for (int32 FrameIndex = 0; FrameIndex < NumFrames; FrameIndex++)
+		{
+			TArray<FQuat> LocalRotations;
+			MakeHandFrame(FrameIndex, RestPose, LocalRotations);
+			TArray<FXRQuantizedJointRotation> Frame;
+			FXRHandJointCodec::QuantizeFrame(LocalRotations, RestPose, Precision, Frame);
+
+			FXRHandJointPacket FullPacket;
+			FullPacket.FrameId = static_cast<uint16>(FrameIndex + 1);
+			FullPacket.Precision = static_cast<uint8>(Precision);
+			FXRHandJointCodec::EncodeDelta(Frame, nullptr, FullPacket);
+
+			FXRHandJointPacket ReceivedFullPacket;
+			int64 NumBits = 0;
+			TestTrue(TEXT("Full packet survives serialization"), RoundTrip(FullPacket, ReceivedFullPacket, NumBits));
+			FullBits += NumBits;
+
+			// Delta against the previous frame, as the owner sends once the server acknowledged it
+			FXRHandJointPacket DeltaPacket;
+			DeltaPacket.FrameId = FullPacket.FrameId;
+			DeltaPacket.BaselineFrameId = PreviousFrame.Num() > 0 ? static_cast<uint16>(FrameIndex) : 0;
+			DeltaPacket.Precision = static_cast<uint8>(Precision);
+			FXRHandJointCodec::EncodeDelta(Frame, PreviousFrame.Num() > 0 ? &PreviousFrame : nullptr, DeltaPacket);
+
+			FXRHandJointPacket ReceivedDeltaPacket;
+			TestTrue(TEXT("Delta packet survives serialization"), RoundTrip(DeltaPacket, ReceivedDeltaPacket, NumBits));
+			DeltaBits += NumBits;
+
+			TArray<FXRQuantizedJointRotation> DecodedFrame;
+			TestTrue(TEXT("Delta packet decodes"), FXRHandJointCodec::DecodeDelta(ReceivedDeltaPacket, PreviousFrame.Num() > 0 ? &PreviousFrame : nullptr, DecodedFrame));
+			TestTrue(TEXT("Delta decoding restores the quantized frame"), DecodedFrame == Frame);
+
+			TArray<FQuat> Reconstructed;
+			FXRHandJointCodec::DequantizeFrame(DecodedFrame, RestPose, Precision, Reconstructed);
+			MaxError = FMath::Max(MaxError, FXRHandJointCodec::GetMaxAngularErrorDegrees(LocalRotations, Reconstructed));
+
+			PreviousFrame = Frame;
+		}
+
+		const float FullBytesPerFrame = FullBits / 8.0f / NumFrames;
+		const float DeltaBytesPerFrame = DeltaBits / 8.0f / NumFrames;
+		AddInfo(FString::Printf(TEXT("Precision %2d: full %6.1f B/frame, delta %6.1f B/frame, max error %.3f deg"), Precision, FullBytesPerFrame, DeltaBytesPerFrame, MaxError));
+
+		// Uncompressed: 26 joints of four floats
+		TestTrue(TEXT("Full frames are smaller than raw quaternions"), FullBytesPerFrame < XRHandJoints::NumJoints * 4 * sizeof(float));
+		TestTrue(TEXT("Delta frames are not larger than full frames"), DeltaBytesPerFrame <= FullBytesPerFrame);
+		// Half a degree at the default precision of 10 bits, halving with every additional bit
+		TestTrue(FString::Printf(TEXT("Reconstruction error at precision %d"), Precision), MaxError < 0.5f * FMath::Pow(2.0f, 10.0f - Precision));
+	}
+
+	// A hand that holds still costs only the header
+	TArray<FQuat> LocalRotations;
+	MakeHandFrame(0, RestPose, LocalRotations);
+	TArray<FXRQuantizedJointRotation> Frame;
+	FXRHandJointCodec::QuantizeFrame(LocalRotations, RestPose, 10, Frame);
+	FXRHandJointPacket StillPacket;
+	FXRHandJointCodec::EncodeDelta(Frame, &Frame, StillPacket);
+	TestEqual(TEXT("Unchanged frame has no changed joints"), StillPacket.ChangedJoints.Num(), 0);
+
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+// A dropped key frame: the deltas against it are rejected instead of being applied to an older key frame, the next key frame recovers.
+// Full frames, as sent through the replicated property, recover with the next frame.
+// ------------------------------------------------------------------------------------------------------------------------------------------------------------
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FXRHandJointKeyFrameLossTest, "XRCore.HandJoints.KeyFrameLoss",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FXRHandJointKeyFrameLossTest::RunTest(const FString& Parameters)
+{
+	using namespace XRHandJointCompressionTests;
+
+	const int32 KeyFrameInterval = 10;
+	const int32 StreamFrames = 3 * KeyFrameInterval;
+	// Second key frame of the stream
+	const uint16 DroppedFrameId = KeyFrameInterval + 1;
+
+	TArray<FQuat> RestPose;
+	MakeRestPose(RestPose);
+
+	FXRHandJointKeyFrameEncoder Encoder;
+	FXRHandJointKeyFrameDecoder KeyFrameDecoder;
+	FXRHandJointKeyFrameDecoder FullFrameDecoder;
+	int32 NumRejected = 0;
+	for (int32 FrameIndex = 0; FrameIndex < StreamFrames; FrameIndex++)
+	{
+		const uint16 FrameId = static_cast<uint16>(FrameIndex + 1);
+		TArray<FQuat> LocalRotations;
+		MakeHandFrame(FrameIndex, RestPose, LocalRotations);
+		TArray<FXRQuantizedJointRotation> Frame;
+		FXRHandJointCodec::QuantizeFrame(LocalRotations, RestPose, 10, Frame);
+
+		FXRHandJointPacket KeyFramePacket;
+		Encoder.Encode(FrameId, 10, Frame, KeyFrameInterval, KeyFramePacket);
+		FXRHandJointPacket FullPacket;
+		FullPacket.FrameId = FrameId;
+		FullPacket.Precision = 10;
+		FXRHandJointCodec::EncodeDelta(Frame, nullptr, FullPacket);
+
+		if (FrameId == DroppedFrameId)
+		{
+			TestEqual(TEXT("Dropped frame is a key frame"), KeyFramePacket.BaselineFrameId, static_cast<uint16>(0));
+			continue;
+		}
+
+		TArray<FXRQuantizedJointRotation> Decoded;
+		const bool bDecoded = KeyFrameDecoder.Decode(KeyFramePacket, Decoded);
+		const bool bAfterLoss = FrameId > DroppedFrameId && FrameId <= DroppedFrameId + KeyFrameInterval - 1;
+		if (bAfterLoss)
+		{
+			TestFalse(FString::Printf(TEXT("Delta %d against the lost key frame is rejected"), FrameId), bDecoded);
+			NumRejected += bDecoded ? 0 : 1;
+		}
+		else
+		{
+			TestTrue(FString::Printf(TEXT("Frame %d decodes"), FrameId), bDecoded);
+			TestTrue(FString::Printf(TEXT("Frame %d is reconstructed exactly"), FrameId), Decoded == Frame);
+		}
+
+		TArray<FXRQuantizedJointRotation> FullDecoded;
+		TestTrue(FString::Printf(TEXT("Full frame %d decodes"), FrameId), FullFrameDecoder.Decode(FullPacket, FullDecoded) && FullDecoded == Frame);
+	}
+	AddInfo(FString::Printf(TEXT("Key frame interval %d: %d delta frames rejected after the lost key frame, full frames lost none"), KeyFrameInterval, NumRejected));
+	return true;
+}
+
+#endif